@@ -0,0 +1,32 @@
+// shaders/activity.frag
+// Builds the per-tile activity map: one texel per 32x32 board tile, set to 1
+// if any cell in the tile differs between the two ping-pong states (i.e. the
+// tile changed in the last generation).
+
+#version 330 core
+out vec4 FragColor;
+
+uniform sampler2D u_stateA; // Newest generation
+uniform sampler2D u_stateB; // Previous generation
+
+void main() {
+    ivec2 tile = ivec2(gl_FragCoord.xy);
+    ivec2 boardSize = textureSize(u_stateA, 0);
+    ivec2 origin = tile * 32;
+
+    bool changed = false;
+    for (int dy = 0; dy < 32 && !changed; ++dy) {
+        int y = origin.y + dy;
+        if (y >= boardSize.y) break;
+        for (int dx = 0; dx < 32; ++dx) {
+            int x = origin.x + dx;
+            if (x >= boardSize.x) break;
+            if (texelFetch(u_stateA, ivec2(x, y), 0).r != texelFetch(u_stateB, ivec2(x, y), 0).r) {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    FragColor = vec4(changed ? 1.0 : 0.0, 0.0, 0.0, 1.0);
+}
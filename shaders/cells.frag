@@ -0,0 +1,14 @@
+// shaders/cells.frag
+// Flat coloring for the instanced high-zoom path: live cells white, dead
+// cells a dark fill just lighter than the background, so the grid lines in
+// the gaps stay visible against both states.
+
+#version 330 core
+flat in float v_state;
+out vec4 FragColor;
+
+void main() {
+    vec3 dead = vec3(0.10);
+    vec3 live = vec3(1.0);
+    FragColor = vec4(v_state > 0.5 ? live : dead, 1.0);
+}
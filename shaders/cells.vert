@@ -0,0 +1,53 @@
+// shaders/cells.vert
+// High-zoom cell renderer: one instanced quad per visible cell, with the
+// cell's state fetched here in the vertex stage - one texelFetch per quad
+// instead of one texture sample per screen pixel. Each quad is inset within
+// its cell so the background shows through the gaps as crisp grid lines.
+
+#version 330 core
+layout (location = 0) in vec2 aPos;
+
+// Per-frame view parameters; the same block draw.vert uses.
+layout(std140) uniform ViewParams {
+    vec2 u_pan;
+    vec2 u_resolution;
+    vec2 u_gridResolution;
+    float u_zoom;
+    float u_lod;
+};
+
+uniform sampler2D u_board;
+uniform int u_rectX; // Visible cell rectangle: origin and width in cells
+uniform int u_rectY;
+uniform int u_rectW;
+
+flat out float v_state;
+
+void main() {
+    ivec2 cell = ivec2(u_rectX + gl_InstanceID % u_rectW,
+                       u_rectY + gl_InstanceID / u_rectW);
+    v_state = texelFetch(u_board, cell, 0).r;
+
+    // Inset the quad's corners within the cell; the uncovered margin is
+    // where the background reads as a grid line.
+    const float inset = 0.06;
+    vec2 corner = (aPos + 1.0) / 2.0;
+    vec2 cellPos = vec2(cell) + inset + corner * (1.0 - 2.0 * inset);
+
+    // Cell space -> texture space -> view quad space (the inverse of the
+    // pan/zoom mapping in draw.vert) -> aspect-corrected NDC.
+    vec2 tex = cellPos / u_gridResolution;
+    vec2 quad = (tex - u_pan) * u_zoom;
+    vec2 ndc = quad * 2.0 - 1.0;
+
+    float windowAspect = u_resolution.x / u_resolution.y;
+    float gridAspect = u_gridResolution.x / u_gridResolution.y;
+    vec2 scale = vec2(1.0);
+    if (windowAspect > gridAspect) {
+        scale.x = gridAspect / windowAspect;
+    } else {
+        scale.y = windowAspect / gridAspect;
+    }
+
+    gl_Position = vec4(ndc * scale, 0.0, 1.0);
+}
@@ -7,6 +7,17 @@ in vec2 v_texCoord;
 
 uniform sampler2D u_currentState;
 
+// Life-like rule as neighbor-count bitmasks: bit n set means the transition
+// happens with n live neighbors. The renderer injects #defines for other
+// rules (Bnnn/Snnn); the defaults are Conway's B3/S23, and the lookup is a
+// single branch-free bit test either way.
+#ifndef BIRTH_MASK
+#define BIRTH_MASK 0x08u
+#endif
+#ifndef SURVIVAL_MASK
+#define SURVIVAL_MASK 0x0Cu
+#endif
+
 // Function to get the state of a cell, handling wrapping automatically due to GL_REPEAT
 float getCellState(vec2 coord) {
     return texture(u_currentState, coord).r;
@@ -28,18 +39,11 @@ void main() {
     
     float currentState = getCellState(v_texCoord);
     aliveNeighbors -= int(currentState); // Exclude the current cell from the count
-    float newState = 0.0;
-    
-    // Apply Conway's Game of Life rules
-    // Rule 1: A living cell with 2 or 3 living neighbours lives on.
-    if (currentState > 0.5 && (aliveNeighbors == 2 || aliveNeighbors == 3)) {
-        newState = 1.0;
-    } 
-    // Rule 2: A dead cell with exactly 3 living neighbours becomes a living cell.
-    else if (currentState < 0.5 && aliveNeighbors == 3) {
-        newState = 1.0;
-    }
-    // All other cells die or stay dead.
-    
+
+    // Apply the rule: live cells consult the survival mask, dead cells the
+    // birth mask, indexed by the neighbor count.
+    uint ruleMask = currentState > 0.5 ? SURVIVAL_MASK : BIRTH_MASK;
+    float newState = float((ruleMask >> uint(aliveNeighbors)) & 1u);
+
     FragColor = vec4(vec3(newState), 1.0);
 }
\ No newline at end of file
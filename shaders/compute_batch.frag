@@ -0,0 +1,52 @@
+// shaders/compute_batch.frag
+// Game of Life step for the ensemble atlas: the texture holds a grid of
+// independent boards packed side by side, and every cell wraps toroidally
+// within its own board, never across a neighbor's edge. One full-screen
+// pass over the atlas advances the whole ensemble one generation.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform sampler2D u_currentState;
+uniform int u_boardWidth;
+uniform int u_boardHeight;
+
+// Life-like rule masks (see compute.frag); defaults are Conway's B3/S23.
+#ifndef BIRTH_MASK
+#define BIRTH_MASK 0x08u
+#endif
+#ifndef SURVIVAL_MASK
+#define SURVIVAL_MASK 0x0Cu
+#endif
+
+// Fetch a cell by board-local coordinates, wrapping within the board whose
+// atlas origin is given. texelFetch ignores the sampler's wrap mode, which
+// is exactly what keeps boards from bleeding into each other.
+float getCell(ivec2 origin, int lx, int ly) {
+    lx = (lx + u_boardWidth) % u_boardWidth;
+    ly = (ly + u_boardHeight) % u_boardHeight;
+    return texelFetch(u_currentState, origin + ivec2(lx, ly), 0).r;
+}
+
+void main() {
+    ivec2 size = textureSize(u_currentState, 0);
+    ivec2 p = ivec2(v_texCoord * vec2(size));
+    ivec2 local = ivec2(p.x % u_boardWidth, p.y % u_boardHeight);
+    ivec2 origin = p - local;
+
+    int aliveNeighbors = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            aliveNeighbors += int(getCell(origin, local.x + dx, local.y + dy) > 0.5);
+        }
+    }
+
+    float currentState = texelFetch(u_currentState, p, 0).r;
+    aliveNeighbors -= int(currentState > 0.5); // Exclude the cell itself
+
+    uint ruleMask = currentState > 0.5 ? SURVIVAL_MASK : BIRTH_MASK;
+    float newState = float((ruleMask >> uint(aliveNeighbors)) & 1u);
+
+    FragColor = vec4(vec3(newState), 1.0);
+}
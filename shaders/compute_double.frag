@@ -0,0 +1,67 @@
+// shaders/compute_double.frag
+// Fused kernel: advances a cell TWO generations in one pass by evaluating
+// the full 5x5 neighborhood (25 taps) instead of running two 9-tap passes
+// with an intermediate texture write and read between them.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform sampler2D u_currentState;
+
+// Life-like rule masks (see compute.frag); defaults are Conway's B3/S23.
+#ifndef BIRTH_MASK
+#define BIRTH_MASK 0x08u
+#endif
+#ifndef SURVIVAL_MASK
+#define SURVIVAL_MASK 0x0Cu
+#endif
+
+float getCellState(vec2 coord) {
+    return texture(u_currentState, coord).r;
+}
+
+// One application of the rule.
+float nextState(float self, int aliveNeighbors) {
+    uint ruleMask = self > 0.5 ? SURVIVAL_MASK : BIRTH_MASK;
+    return float((ruleMask >> uint(aliveNeighbors)) & 1u);
+}
+
+void main() {
+    vec2 pixel = 1.0 / textureSize(u_currentState, 0);
+
+    // Generation n: the 5x5 neighborhood, fetched once.
+    float cells[25];
+    for (int dy = -2; dy <= 2; ++dy) {
+        for (int dx = -2; dx <= 2; ++dx) {
+            cells[(dy + 2) * 5 + (dx + 2)] = getCellState(v_texCoord + vec2(float(dx), float(dy)) * pixel);
+        }
+    }
+
+    // Generation n+1: the inner 3x3, each from its own 3x3 window.
+    float mid[9];
+    for (int my = 0; my < 3; ++my) {
+        for (int mx = 0; mx < 3; ++mx) {
+            int cx = mx + 1, cy = my + 1; // Position inside the 5x5
+            int aliveNeighbors = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    aliveNeighbors += int(cells[(cy + dy) * 5 + (cx + dx)]);
+                }
+            }
+            float self = cells[cy * 5 + cx];
+            aliveNeighbors -= int(self);
+            mid[my * 3 + mx] = nextState(self, aliveNeighbors);
+        }
+    }
+
+    // Generation n+2: the center cell from the intermediate 3x3.
+    int aliveNeighbors = 0;
+    for (int i = 0; i < 9; ++i) {
+        aliveNeighbors += int(mid[i]);
+    }
+    float self = mid[4];
+    aliveNeighbors -= int(self);
+
+    FragColor = vec4(vec3(nextState(self, aliveNeighbors)), 1.0);
+}
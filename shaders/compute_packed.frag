@@ -0,0 +1,69 @@
+// shaders/compute_packed.frag
+// Game of Life logic for the bit-packed board: each R32UI texel holds 32 cells.
+// One fragment invocation advances one 32-cell word, so the whole word's
+// neighborhood is covered by just 9 integer texel fetches.
+
+#version 330 core
+layout (location = 0) out uint FragColor;
+in vec2 v_texCoord;
+
+uniform usampler2D u_currentState;
+
+// Life-like rule masks (see compute.frag); defaults are Conway's B3/S23.
+#ifndef BIRTH_MASK
+#define BIRTH_MASK 0x08u
+#endif
+#ifndef SURVIVAL_MASK
+#define SURVIVAL_MASK 0x0Cu
+#endif
+
+// Fetch one packed word with toroidal wrapping. texelFetch ignores the
+// sampler's GL_REPEAT mode, so the wrap has to be done by hand here.
+uint getWord(int wx, int wy, ivec2 size) {
+    wx = (wx + size.x) % size.x;
+    wy = (wy + size.y) % size.y;
+    return texelFetch(u_currentState, ivec2(wx, wy), 0).r;
+}
+
+// Extract bit i (0..31) from a 3-word window (left, center, right), where
+// i = -1 reads the top bit of the left word and i = 32 reads the bottom bit
+// of the right word. The grid width is a multiple of 32, so word-level
+// wrapping is exact.
+uint windowBit(uint left, uint center, uint right, int i) {
+    if (i < 0)  return (left >> 31) & 1u;
+    if (i > 31) return right & 1u;
+    return (center >> uint(i)) & 1u;
+}
+
+void main() {
+    ivec2 size = textureSize(u_currentState, 0);
+    ivec2 word = ivec2(v_texCoord * vec2(size));
+
+    // Load the 3x3 word neighborhood once; everything below is register math.
+    uint rowT_l = getWord(word.x - 1, word.y - 1, size);
+    uint rowT_c = getWord(word.x,     word.y - 1, size);
+    uint rowT_r = getWord(word.x + 1, word.y - 1, size);
+    uint rowM_l = getWord(word.x - 1, word.y,     size);
+    uint rowM_c = getWord(word.x,     word.y,     size);
+    uint rowM_r = getWord(word.x + 1, word.y,     size);
+    uint rowB_l = getWord(word.x - 1, word.y + 1, size);
+    uint rowB_c = getWord(word.x,     word.y + 1, size);
+    uint rowB_r = getWord(word.x + 1, word.y + 1, size);
+
+    uint newWord = 0u;
+    for (int i = 0; i < 32; ++i) {
+        uint neighbors = 0u;
+        for (int di = -1; di <= 1; ++di) {
+            neighbors += windowBit(rowT_l, rowT_c, rowT_r, i + di);
+            neighbors += windowBit(rowM_l, rowM_c, rowM_r, i + di);
+            neighbors += windowBit(rowB_l, rowB_c, rowB_r, i + di);
+        }
+        uint self = (rowM_c >> uint(i)) & 1u;
+        neighbors -= self; // Exclude the cell itself from the count
+
+        uint ruleMask = self == 1u ? SURVIVAL_MASK : BIRTH_MASK;
+        newWord |= ((ruleMask >> neighbors) & 1u) << uint(i);
+    }
+
+    FragColor = newWord;
+}
@@ -0,0 +1,58 @@
+// shaders/compute_tiled.frag
+// Game of Life step for the tiled virtual grid. The board lives in a
+// GL_TEXTURE_2D_ARRAY of square tiles; each pass renders one destination
+// layer. Neighbor fetches go through global cell coordinates, which wrap
+// toroidally at the board edges and are then mapped to a (layer, texel)
+// pair - so tile seams need no halo exchange at all.
+
+#version 330 core
+out vec4 FragColor;
+
+uniform sampler2DArray u_currentState;
+
+// Life-like rule masks (see compute.frag); defaults are Conway's B3/S23.
+#ifndef BIRTH_MASK
+#define BIRTH_MASK 0x08u
+#endif
+#ifndef SURVIVAL_MASK
+#define SURVIVAL_MASK 0x0Cu
+#endif
+uniform int u_gridWidth;
+uniform int u_gridHeight;
+uniform int u_tileSize;
+uniform int u_tileCols;
+uniform int u_tileOriginX; // Board coordinate of this layer's lower-left texel
+uniform int u_tileOriginY;
+
+float fetchCell(ivec2 g) {
+    g.x = (g.x + u_gridWidth) % u_gridWidth;
+    g.y = (g.y + u_gridHeight) % u_gridHeight;
+    ivec2 tile = g / u_tileSize;
+    ivec2 local = g - tile * u_tileSize;
+    return texelFetch(u_currentState, ivec3(local, tile.y * u_tileCols + tile.x), 0).r;
+}
+
+void main() {
+    ivec2 g = ivec2(gl_FragCoord.xy) + ivec2(u_tileOriginX, u_tileOriginY);
+
+    // Edge tiles can extend past the board; that padding stays dead.
+    if (g.x >= u_gridWidth || g.y >= u_gridHeight) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    int aliveNeighbors = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            aliveNeighbors += int(fetchCell(g + ivec2(dx, dy)));
+        }
+    }
+
+    float currentState = fetchCell(g);
+    aliveNeighbors -= int(currentState);
+
+    uint ruleMask = currentState > 0.5 ? SURVIVAL_MASK : BIRTH_MASK;
+    float newState = float((ruleMask >> uint(aliveNeighbors)) & 1u);
+
+    FragColor = vec4(vec3(newState), 1.0);
+}
@@ -7,11 +7,26 @@ in vec2 v_texCoord;
 
 uniform sampler2D u_screenTexture;
 
+// Must match the block in draw.vert (only u_lod is used here).
+layout(std140) uniform ViewParams {
+    vec2 u_pan;
+    vec2 u_resolution;
+    vec2 u_gridResolution;
+    float u_zoom;
+    float u_lod;
+};
+
 void main() {
     // If the panned/zoomed coordinate is outside the [0,1] texture range,
     // draw the background color. This prevents wrapping artifacts.
     if (v_texCoord.x < 0.0 || v_texCoord.x > 1.0 || v_texCoord.y < 0.0 || v_texCoord.y > 1.0) {
         FragColor = vec4(0.05, 0.05, 0.05, 1.0); // Background color
+    } else if (u_lod > 0.0) {
+        // Zoomed out: sample the averaged mip pyramid. The value is the
+        // local live-cell density, so dense regions read brighter instead
+        // of flickering as individual cells alias in and out.
+        float density = textureLod(u_screenTexture, v_texCoord, u_lod).r;
+        FragColor = vec4(vec3(density), 1.0);
     } else {
         // Otherwise, draw the cell from the simulation texture
         float cellState = texture(u_screenTexture, v_texCoord).r;
@@ -5,10 +5,15 @@ layout (location = 0) in vec2 aPos;
 
 out vec2 v_texCoord;
 
-uniform vec2 u_pan;
-uniform float u_zoom;
-uniform vec2 u_resolution;
-uniform vec2 u_gridResolution;
+// Per-frame view parameters, shared with the fragment stage through one
+// uniform buffer update instead of individual glUniform calls.
+layout(std140) uniform ViewParams {
+    vec2 u_pan;
+    vec2 u_resolution;
+    vec2 u_gridResolution;
+    float u_zoom;
+    float u_lod;
+};
 
 void main() {
     // 1. First, calculate the correct texture coordinates for sampling.
@@ -0,0 +1,33 @@
+// shaders/draw_packed.frag
+// Fragment shader for drawing the bit-packed board. It unpacks the cell bit
+// from the R32UI word that covers the sampled texture coordinate.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform usampler2D u_screenTexture;
+
+// Must match the block in draw.vert (only u_gridResolution is used here).
+layout(std140) uniform ViewParams {
+    vec2 u_pan;
+    vec2 u_resolution;
+    vec2 u_gridResolution;
+    float u_zoom;
+    float u_lod; // Unused here; the packed board has no averageable mips
+};
+
+void main() {
+    // If the panned/zoomed coordinate is outside the [0,1] texture range,
+    // draw the background color. This prevents wrapping artifacts.
+    if (v_texCoord.x < 0.0 || v_texCoord.x > 1.0 || v_texCoord.y < 0.0 || v_texCoord.y > 1.0) {
+        FragColor = vec4(0.05, 0.05, 0.05, 1.0); // Background color
+    } else {
+        // Map the coordinate to a logical cell, then to its word and bit.
+        int cellX = int(v_texCoord.x * u_gridResolution.x);
+        int cellY = int(v_texCoord.y * u_gridResolution.y);
+        uint word = texelFetch(u_screenTexture, ivec2(cellX / 32, cellY), 0).r;
+        float cellState = float((word >> uint(cellX % 32)) & 1u);
+        FragColor = vec4(vec3(cellState), 1.0);
+    }
+}
@@ -0,0 +1,35 @@
+// shaders/draw_tiled.frag
+// Fragment shader for drawing the tiled virtual grid: maps the panned/zoomed
+// texture coordinate to a global cell, then to its tile layer and local texel.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform sampler2DArray u_screenTexture;
+uniform int u_tileSize;
+uniform int u_tileCols;
+
+// Must match the block in draw.vert (only u_gridResolution is used here).
+layout(std140) uniform ViewParams {
+    vec2 u_pan;
+    vec2 u_resolution;
+    vec2 u_gridResolution;
+    float u_zoom;
+    float u_lod;
+};
+
+void main() {
+    // If the panned/zoomed coordinate is outside the [0,1] texture range,
+    // draw the background color. This prevents wrapping artifacts.
+    if (v_texCoord.x < 0.0 || v_texCoord.x > 1.0 || v_texCoord.y < 0.0 || v_texCoord.y > 1.0) {
+        FragColor = vec4(0.05, 0.05, 0.05, 1.0); // Background color
+    } else {
+        ivec2 g = ivec2(v_texCoord * u_gridResolution);
+        g = min(g, ivec2(u_gridResolution) - 1);
+        ivec2 tile = g / u_tileSize;
+        ivec2 local = g - tile * u_tileSize;
+        float cellState = texelFetch(u_screenTexture, ivec3(local, tile.y * u_tileCols + tile.x), 0).r;
+        FragColor = vec4(vec3(cellState), 1.0);
+    }
+}
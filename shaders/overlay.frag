@@ -0,0 +1,16 @@
+#version 330 core
+
+// Draws the console overlay's text bitmap: light glyphs on a translucent
+// dark bar so the line stays readable over any board.
+
+in vec2 v_texCoord;
+out vec4 FragColor;
+
+uniform sampler2D u_text;
+
+void main()
+{
+    float glyph = texture(u_text, v_texCoord).r;
+    vec3 color = mix(vec3(0.08, 0.08, 0.08), vec3(0.95, 0.95, 0.95), glyph);
+    FragColor = vec4(color, 0.85);
+}
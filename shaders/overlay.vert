@@ -0,0 +1,18 @@
+#version 330 core
+
+// Places the console overlay's unit quad at a pixel-aligned rectangle given
+// in normalized device coordinates by the application.
+
+layout(location = 0) in vec2 a_position; // Unit quad, (0,0) bottom-left
+
+uniform vec2 u_rectOrigin; // Bottom-left corner in NDC
+uniform vec2 u_rectSize;   // Width/height in NDC
+
+out vec2 v_texCoord;
+
+void main()
+{
+    // The text bitmap's row 0 is the top of the glyphs; flip vertically.
+    v_texCoord = vec2(a_position.x, 1.0 - a_position.y);
+    gl_Position = vec4(u_rectOrigin + a_position * u_rectSize, 0.0, 1.0);
+}
@@ -0,0 +1,24 @@
+// shaders/randomize.frag
+// Fills the float board with a 50/50 random state directly on the GPU.
+// Uses a PCG-style integer hash per cell, so the result is instant at any
+// grid size and fully reproducible from the seed uniform.
+
+#version 330 core
+out vec4 FragColor;
+
+uniform uint u_seed;
+
+// PCG output function over a 32-bit state (O'Neill's pcg32 variant).
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void main() {
+    // A unique stream per cell: hash the pixel coordinates with the seed.
+    uint x = uint(gl_FragCoord.x);
+    uint y = uint(gl_FragCoord.y);
+    uint h = pcgHash(pcgHash(x) + pcgHash(y * 9781u) + u_seed);
+    FragColor = vec4(vec3(float(h & 1u)), 1.0);
+}
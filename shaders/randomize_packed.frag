@@ -0,0 +1,21 @@
+// shaders/randomize_packed.frag
+// GPU randomize for the bit-packed board: one hashed 32-bit word per texel
+// gives 32 independent fair coin flips at once.
+
+#version 330 core
+layout (location = 0) out uint FragColor;
+
+uniform uint u_seed;
+
+// PCG output function over a 32-bit state (O'Neill's pcg32 variant).
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void main() {
+    uint x = uint(gl_FragCoord.x);
+    uint y = uint(gl_FragCoord.y);
+    FragColor = pcgHash(pcgHash(x) + pcgHash(y * 9781u) + u_seed);
+}
@@ -0,0 +1,33 @@
+// shaders/randomize_tiled.frag
+// Random fill for the tiled virtual grid. Hashes the global cell coordinate
+// (tile origin + fragment position), so the same seed produces the same
+// board regardless of how it happens to be tiled.
+
+#version 330 core
+out vec4 FragColor;
+
+uniform uint u_seed;
+uniform int u_gridWidth;
+uniform int u_gridHeight;
+uniform int u_tileOriginX;
+uniform int u_tileOriginY;
+
+// PCG output function over a 32-bit state (O'Neill's pcg32 variant).
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void main() {
+    ivec2 g = ivec2(gl_FragCoord.xy) + ivec2(u_tileOriginX, u_tileOriginY);
+
+    // Edge tiles can extend past the board; that padding stays dead.
+    if (g.x >= u_gridWidth || g.y >= u_gridHeight) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    uint h = pcgHash(pcgHash(uint(g.x)) + pcgHash(uint(g.y) * 9781u) + u_seed);
+    FragColor = vec4(vec3(float(h & 1u)), 1.0);
+}
@@ -0,0 +1,30 @@
+// shaders/signature.frag
+// Board checksum pass for stabilization detection: every live cell
+// contributes a per-position pseudo-random weight, and the target texture's
+// mip chain then averages the result down to a single float. Identical
+// boards always reduce to the bit-identical float, which is all the
+// cycle-detection window on the CPU side needs to compare.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform sampler2D u_board;
+
+// PCG output function over a 32-bit state (same hash as randomize.frag).
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void main() {
+    ivec2 size = textureSize(u_board, 0);
+    ivec2 cell = ivec2(v_texCoord * vec2(size));
+    float alive = texelFetch(u_board, cell, 0).r > 0.5 ? 1.0 : 0.0;
+
+    // A distinct weight per cell position, so a live cell moving by one
+    // texel changes the board's average and therefore its signature.
+    uint h = pcgHash(pcgHash(uint(cell.x)) + pcgHash(uint(cell.y) * 9781u));
+    FragColor = vec4(vec3(alive * (float(h) / 4294967295.0)), 1.0);
+}
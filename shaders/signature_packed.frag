@@ -0,0 +1,28 @@
+// shaders/signature_packed.frag
+// Board checksum pass for the bit-packed board (see signature.frag): the
+// whole 32-cell word is folded through the position hash, so any bit
+// flipping anywhere in the word moves the signature. Dead words contribute
+// exactly zero, keeping empty regions stable in the average.
+
+#version 330 core
+out vec4 FragColor;
+in vec2 v_texCoord;
+
+uniform usampler2D u_board;
+
+// PCG output function over a 32-bit state (same hash as randomize.frag).
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void main() {
+    ivec2 size = textureSize(u_board, 0);
+    ivec2 texel = ivec2(v_texCoord * vec2(size));
+    uint word = texelFetch(u_board, texel, 0).r;
+
+    uint h = pcgHash(word + pcgHash(uint(texel.x)) + pcgHash(uint(texel.y) * 9781u));
+    float weighted = word == 0u ? 0.0 : float(h) / 4294967295.0;
+    FragColor = vec4(vec3(weighted), 1.0);
+}
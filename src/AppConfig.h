@@ -0,0 +1,61 @@
+// src/AppConfig.h
+// Startup configuration parsed from the command line in main.cpp and handed
+// down to GameOfLife/Renderer. Keeps the constructor signatures stable as
+// options accumulate.
+
+#pragma once
+
+#include <string>
+
+struct AppConfig {
+    // Board storage: 32 cells per R32UI texel instead of one float per cell.
+    bool packedBoard = false;
+
+    // Run the simulation step as a GL 4.3 compute dispatch when available.
+    bool useCompute = false;
+
+    // Headless benchmark: hidden window, benchGenerations back-to-back steps
+    // on a benchWidth x benchHeight grid, then throughput report and exit.
+    bool benchmark = false;
+    int benchWidth = 0;
+    int benchHeight = 0;
+    int benchGenerations = 0;
+
+    // When set, per-stage GPU timings are appended to this CSV file once a
+    // second (wall_time,fps,sim_ms,draw_ms).
+    std::string timingLogPath;
+
+    // Life-like rule in Bnnn/Snnn notation, compiled into the step kernels.
+    std::string rule = "B3/S23";
+
+    // Run the simulation on a worker thread with a shared GL context,
+    // stepping continuously regardless of draw cost or V-Sync (soak runs).
+    bool threaded = false;
+
+    // Determinism: seed the initial board fill instead of std::random_device,
+    // record board mutations to a log, and/or replay a recorded log so two
+    // runs evolve identical boards (see MutationLog.h).
+    unsigned int seed = 0;
+    bool hasSeed = false;
+    std::string recordLogPath;
+    std::string replayLogPath;
+
+    // Ensemble batch mode: batchCount independent boards of batchWidth x
+    // batchHeight packed into one atlas texture and stepped together, one
+    // pass per generation, headless (see BatchRunner.h). Nonzero batchCount
+    // enables it.
+    int batchCount = 0;
+    int batchWidth = 0;
+    int batchHeight = 0;
+    int batchGenerations = 0;
+
+    // Stop automatically once the board settles into a still life or a
+    // short-period oscillator: pause in interactive mode, end the run early
+    // in --bench (see Renderer::enableAutoStop).
+    bool autoStop = false;
+
+    // Timelapse recording: every exportEvery-th generation is read back
+    // asynchronously and written as a PGM sequence into exportDir.
+    std::string exportDir;
+    int exportEvery = 0;
+};
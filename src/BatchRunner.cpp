@@ -0,0 +1,143 @@
+// src/BatchRunner.cpp
+// Implementation of the ensemble batch runner.
+
+#include "BatchRunner.h"
+#include "RuleParser.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+BatchRunner::BatchRunner(int count, int width, int height, unsigned int s, const std::string& rule)
+    : boardCount(count), boardWidth(width), boardHeight(height), seed(s) {
+
+    // Near-square layout keeps the atlas within the driver's (usually
+    // square) texture limit for the largest ensembles.
+    atlasCols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(boardCount))));
+    atlasRows = (boardCount + atlasCols - 1) / atlasCols;
+    atlasWidth = atlasCols * boardWidth;
+    atlasHeight = atlasRows * boardHeight;
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (atlasWidth > maxTextureSize || atlasHeight > maxTextureSize) {
+        throw std::runtime_error("Batch atlas " + std::to_string(atlasWidth) + "x"
+            + std::to_string(atlasHeight) + " exceeds GL_MAX_TEXTURE_SIZE ("
+            + std::to_string(maxTextureSize) + "); use fewer or smaller boards");
+    }
+
+    unsigned int birthMask = 0, survivalMask = 0;
+    parseLifeRule(rule, birthMask, survivalMask);
+    stepProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute_batch.frag",
+        makeRulePreamble(birthMask, survivalMask));
+    randomizeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/randomize.frag");
+
+    float quadVertices[] = { -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f };
+    glGenVertexArrays(1, &quadVAO);
+    glGenBuffers(1, &quadVBO);
+    glBindVertexArray(quadVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glBindVertexArray(0);
+
+    // Ping-pong atlas pair. Filtering and wrap modes are irrelevant here:
+    // the batch kernel only uses texelFetch with its own per-board wrap.
+    glGenTextures(2, textures);
+    glGenFramebuffers(2, fbo);
+    for (int i = 0; i < 2; ++i) {
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, atlasWidth, atlasHeight, 0, GL_RED, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[i], 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            throw std::runtime_error("Batch atlas framebuffer is not complete");
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    std::cout << "Batch: " << boardCount << " boards of " << boardWidth << "x" << boardHeight
+        << " in a " << atlasCols << "x" << atlasRows << " atlas ("
+        << atlasWidth << "x" << atlasHeight << " texels), seed " << seed << "." << std::endl;
+}
+
+BatchRunner::~BatchRunner() {
+    glDeleteVertexArrays(1, &quadVAO);
+    glDeleteBuffers(1, &quadVBO);
+    glDeleteFramebuffers(2, fbo);
+    glDeleteTextures(2, textures);
+}
+
+void BatchRunner::run(int generations) {
+    glViewport(0, 0, atlasWidth, atlasHeight);
+    glBindVertexArray(quadVAO);
+
+    // One randomize pass fills every board; the hash is keyed by absolute
+    // texel position, so boards are independent draws from the same seed.
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[currentTextureIndex]);
+    randomizeProgram->use();
+    randomizeProgram->setUInt("u_seed", seed);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    stepProgram->use();
+    stepProgram->setInt("u_currentState", 0);
+    stepProgram->setInt("u_boardWidth", boardWidth);
+    stepProgram->setInt("u_boardHeight", boardHeight);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    glFinish();
+    glBeginQuery(GL_TIME_ELAPSED, query);
+
+    double wallStart = glfwGetTime();
+    for (int i = 0; i < generations; ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+        glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        currentTextureIndex = 1 - currentTextureIndex;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glFinish();
+    double wallSeconds = glfwGetTime() - wallStart;
+
+    GLuint64 gpuNanos = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &gpuNanos);
+    glDeleteQueries(1, &query);
+
+    const double cells = static_cast<double>(boardWidth) * boardHeight * boardCount;
+    const double generationsPerSec = generations / wallSeconds;
+    std::cout << "Wall time:        " << wallSeconds * 1000.0 << " ms\n"
+        << "Generations/sec:  " << generationsPerSec << "\n"
+        << "Cell-updates/sec: " << generationsPerSec * cells << "\n"
+        << "GPU time/step:    " << (gpuNanos / 1e6) / generations << " ms" << std::endl;
+
+    // One synchronous readback of the whole atlas for the per-board report.
+    // The run is over, so there is no pipeline left to stall.
+    std::vector<float> atlas(static_cast<size_t>(atlasWidth) * atlasHeight);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glReadPixels(0, 0, atlasWidth, atlasHeight, GL_RED, GL_FLOAT, atlas.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    std::cout << "Final populations (board: population):" << std::endl;
+    for (int b = 0; b < boardCount; ++b) {
+        int ox = (b % atlasCols) * boardWidth;
+        int oy = (b / atlasCols) * boardHeight;
+        long long population = 0;
+        for (int y = 0; y < boardHeight; ++y) {
+            const float* row = &atlas[static_cast<size_t>(oy + y) * atlasWidth + ox];
+            for (int x = 0; x < boardWidth; ++x) {
+                if (row[x] > 0.5f) ++population;
+            }
+        }
+        std::cout << "  " << b << ": " << population << "\n";
+    }
+    std::cout << std::flush;
+}
@@ -0,0 +1,223 @@
+// src/Checkpoint.cpp
+// Implementation of the checkpoint format.
+//
+// File layout (all integers little-endian):
+//   "GOLC"            4-byte magic
+//   version           uint32 (currently 1)
+//   width, height     int32 each, in cells
+//   generation        uint64
+//   seed              uint32
+//   packedSize        uint64, size of the bit-packed board before compression
+//   <RLE stream>      to end of file
+//
+// The RLE is byte-oriented with one control byte per run: c < 128 means the
+// next c+1 bytes are literals; c >= 128 means the next byte repeats c-125
+// times (runs of 3..130). Bit-packed boards are dominated by long 0x00 and
+// 0xFF runs, so this typically shrinks sparse boards by well over 10x while
+// decoding at memcpy-like speed.
+
+#include "Checkpoint.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHECKPOINT_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    constexpr char MAGIC[4] = { 'G', 'O', 'L', 'C' };
+    constexpr std::uint32_t VERSION = 1;
+
+    std::vector<unsigned char> rleEncode(const std::vector<unsigned char>& data) {
+        std::vector<unsigned char> out;
+        out.reserve(data.size() / 8 + 16);
+        size_t i = 0;
+        size_t literalStart = 0;
+
+        auto flushLiterals = [&](size_t end) {
+            // Literal runs carry at most 128 bytes per control byte.
+            while (literalStart < end) {
+                size_t n = std::min<size_t>(end - literalStart, 128);
+                out.push_back(static_cast<unsigned char>(n - 1));
+                out.insert(out.end(), data.begin() + literalStart, data.begin() + literalStart + n);
+                literalStart += n;
+            }
+        };
+
+        while (i < data.size()) {
+            size_t run = 1;
+            while (i + run < data.size() && data[i + run] == data[i] && run < 130) {
+                ++run;
+            }
+            if (run >= 3) {
+                flushLiterals(i);
+                out.push_back(static_cast<unsigned char>(run + 125)); // 3..130 -> 128..255
+                out.push_back(data[i]);
+                i += run;
+                literalStart = i;
+            }
+            else {
+                i += run;
+            }
+        }
+        flushLiterals(data.size());
+        return out;
+    }
+
+    void rleDecode(const unsigned char* in, size_t inSize, unsigned char* out, size_t outSize) {
+        size_t i = 0, o = 0;
+        while (i < inSize) {
+            unsigned char c = in[i++];
+            if (c < 128) {
+                size_t n = static_cast<size_t>(c) + 1;
+                if (i + n > inSize || o + n > outSize) {
+                    throw std::runtime_error("Checkpoint: corrupt RLE stream");
+                }
+                std::memcpy(out + o, in + i, n);
+                i += n;
+                o += n;
+            }
+            else {
+                size_t n = static_cast<size_t>(c) - 125;
+                if (i >= inSize || o + n > outSize) {
+                    throw std::runtime_error("Checkpoint: corrupt RLE stream");
+                }
+                std::memset(out + o, in[i++], n);
+                o += n;
+            }
+        }
+        if (o != outSize) {
+            throw std::runtime_error("Checkpoint: truncated RLE stream");
+        }
+    }
+
+    template <typename T>
+    T readField(const unsigned char*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+} // namespace
+
+void CheckpointFile::write(const std::string& path, int width, int height,
+    unsigned long long generation, unsigned int seed,
+    const std::vector<unsigned char>& packedRows) {
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Checkpoint: could not open " + path + " for writing");
+    }
+
+    file.write(MAGIC, 4);
+    std::uint32_t version = VERSION;
+    std::int32_t dims[2] = { width, height };
+    std::uint64_t gen = generation;
+    std::uint32_t seed32 = seed;
+    std::uint64_t packedSize = packedRows.size();
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    file.write(reinterpret_cast<const char*>(&gen), sizeof(gen));
+    file.write(reinterpret_cast<const char*>(&seed32), sizeof(seed32));
+    file.write(reinterpret_cast<const char*>(&packedSize), sizeof(packedSize));
+
+    std::vector<unsigned char> compressed = rleEncode(packedRows);
+    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+
+    if (!file) {
+        throw std::runtime_error("Checkpoint: write to " + path + " failed");
+    }
+}
+
+Checkpoint CheckpointFile::load(const std::string& path) {
+    // Get the whole file into memory: memory-mapped where available (the
+    // kernel pages it in as the decoder streams through), plain read
+    // otherwise.
+    const unsigned char* fileData = nullptr;
+    size_t fileSize = 0;
+    std::vector<unsigned char> fallback;
+
+#if CHECKPOINT_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Checkpoint: could not open " + path);
+    }
+    struct stat st;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        fileSize = static_cast<size_t>(st.st_size);
+        mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Checkpoint: could not map " + path);
+    }
+    fileData = static_cast<const unsigned char*>(mapping);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Checkpoint: could not open " + path);
+    }
+    fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+    fallback.resize(fileSize);
+    file.read(reinterpret_cast<char*>(fallback.data()), fileSize);
+    fileData = fallback.data();
+#endif
+
+    Checkpoint checkpoint;
+    try {
+        constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 8 + 4 + 8;
+        if (fileSize < HEADER_SIZE || std::memcmp(fileData, MAGIC, 4) != 0) {
+            throw std::runtime_error("Checkpoint: " + path + " is not a checkpoint file");
+        }
+        const unsigned char* p = fileData + 4;
+        std::uint32_t version = readField<std::uint32_t>(p);
+        if (version != VERSION) {
+            throw std::runtime_error("Checkpoint: unsupported version in " + path);
+        }
+        checkpoint.width = readField<std::int32_t>(p);
+        checkpoint.height = readField<std::int32_t>(p);
+        checkpoint.generation = readField<std::uint64_t>(p);
+        checkpoint.seed = readField<std::uint32_t>(p);
+        std::uint64_t packedSize = readField<std::uint64_t>(p);
+
+        if (checkpoint.width <= 0 || checkpoint.height <= 0 ||
+            packedSize != static_cast<std::uint64_t>((checkpoint.width + 7) / 8) * checkpoint.height) {
+            throw std::runtime_error("Checkpoint: inconsistent header in " + path);
+        }
+
+        std::vector<unsigned char> packed(static_cast<size_t>(packedSize));
+        rleDecode(p, fileSize - HEADER_SIZE, packed.data(), packed.size());
+
+        // Expand bit-packed rows to the row-major 0/1 layout the renderer
+        // uploads directly with glTexSubImage2D.
+        const int bytesPerRow = (checkpoint.width + 7) / 8;
+        checkpoint.cells.resize(static_cast<size_t>(checkpoint.width) * checkpoint.height);
+        for (int y = 0; y < checkpoint.height; ++y) {
+            const unsigned char* row = packed.data() + static_cast<size_t>(y) * bytesPerRow;
+            for (int x = 0; x < checkpoint.width; ++x) {
+                checkpoint.cells[static_cast<size_t>(y) * checkpoint.width + x] = (row[x / 8] >> (x % 8)) & 1u;
+            }
+        }
+    }
+    catch (...) {
+#if CHECKPOINT_HAS_MMAP
+        ::munmap(const_cast<unsigned char*>(fileData), fileSize);
+#endif
+        throw;
+    }
+
+#if CHECKPOINT_HAS_MMAP
+    ::munmap(const_cast<unsigned char*>(fileData), fileSize);
+#endif
+    return checkpoint;
+}
@@ -0,0 +1,34 @@
+// src/Checkpoint.h
+// The board checkpoint file format (.golc): a small fixed header carrying
+// the dimensions, generation number and RNG seed, followed by the bit-packed
+// board run-length encoded. Writing goes through SnapshotWriter's background
+// thread; loading memory-maps the file where the platform allows it, so load
+// time is bounded by decompression bandwidth rather than parsing.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// A fully decoded checkpoint, with the board expanded to row-major 0/1 bytes.
+struct Checkpoint {
+    int width = 0;
+    int height = 0;
+    unsigned long long generation = 0;
+    unsigned int seed = 0;
+    std::vector<unsigned char> cells;
+};
+
+class CheckpointFile {
+public:
+    // Writes a checkpoint. `packedRows` is the board bit-packed LSB-first at
+    // 8 cells per byte, rows bottom-to-top (GL order), each row padded to a
+    // whole byte. Throws std::runtime_error on I/O failure.
+    static void write(const std::string& path, int width, int height,
+        unsigned long long generation, unsigned int seed,
+        const std::vector<unsigned char>& packedRows);
+
+    // Loads and fully decodes a checkpoint. Throws std::runtime_error on a
+    // missing file, bad magic, or a truncated/corrupt stream.
+    static Checkpoint load(const std::string& path);
+};
@@ -0,0 +1,242 @@
+// src/ConsoleOverlay.cpp
+// Implementation of the in-window command overlay.
+
+#include "ConsoleOverlay.h"
+#include <GLFW/glfw3.h>
+#include <vector>
+
+namespace {
+
+    // 8x8 bitmap font for ASCII 32..126 (the public domain "font8x8" set).
+    // One byte per row, top row first, least significant bit is the leftmost
+    // pixel. Under a kilobyte of data buys us text without any font library.
+    const unsigned char FONT8X8[95][8] = {
+        { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 }, // ' '
+        { 0x18,0x3C,0x3C,0x18,0x18,0x00,0x18,0x00 }, // '!'
+        { 0x36,0x36,0x00,0x00,0x00,0x00,0x00,0x00 }, // '"'
+        { 0x36,0x36,0x7F,0x36,0x7F,0x36,0x36,0x00 }, // '#'
+        { 0x0C,0x3E,0x03,0x1E,0x30,0x1F,0x0C,0x00 }, // '$'
+        { 0x00,0x63,0x33,0x18,0x0C,0x66,0x63,0x00 }, // '%'
+        { 0x1C,0x36,0x1C,0x6E,0x3B,0x33,0x6E,0x00 }, // '&'
+        { 0x06,0x06,0x03,0x00,0x00,0x00,0x00,0x00 }, // '\''
+        { 0x18,0x0C,0x06,0x06,0x06,0x0C,0x18,0x00 }, // '('
+        { 0x06,0x0C,0x18,0x18,0x18,0x0C,0x06,0x00 }, // ')'
+        { 0x00,0x66,0x3C,0xFF,0x3C,0x66,0x00,0x00 }, // '*'
+        { 0x00,0x0C,0x0C,0x3F,0x0C,0x0C,0x00,0x00 }, // '+'
+        { 0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x06 }, // ','
+        { 0x00,0x00,0x00,0x3F,0x00,0x00,0x00,0x00 }, // '-'
+        { 0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x00 }, // '.'
+        { 0x60,0x30,0x18,0x0C,0x06,0x03,0x01,0x00 }, // '/'
+        { 0x3E,0x63,0x73,0x7B,0x6F,0x67,0x3E,0x00 }, // '0'
+        { 0x0C,0x0E,0x0C,0x0C,0x0C,0x0C,0x3F,0x00 }, // '1'
+        { 0x1E,0x33,0x30,0x1C,0x06,0x33,0x3F,0x00 }, // '2'
+        { 0x1E,0x33,0x30,0x1C,0x30,0x33,0x1E,0x00 }, // '3'
+        { 0x38,0x3C,0x36,0x33,0x7F,0x30,0x78,0x00 }, // '4'
+        { 0x3F,0x03,0x1F,0x30,0x30,0x33,0x1E,0x00 }, // '5'
+        { 0x1C,0x06,0x03,0x1F,0x33,0x33,0x1E,0x00 }, // '6'
+        { 0x3F,0x33,0x30,0x18,0x0C,0x0C,0x0C,0x00 }, // '7'
+        { 0x1E,0x33,0x33,0x1E,0x33,0x33,0x1E,0x00 }, // '8'
+        { 0x1E,0x33,0x33,0x3E,0x30,0x18,0x0E,0x00 }, // '9'
+        { 0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x00 }, // ':'
+        { 0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x06 }, // ';'
+        { 0x18,0x0C,0x06,0x03,0x06,0x0C,0x18,0x00 }, // '<'
+        { 0x00,0x00,0x3F,0x00,0x00,0x3F,0x00,0x00 }, // '='
+        { 0x06,0x0C,0x18,0x30,0x18,0x0C,0x06,0x00 }, // '>'
+        { 0x1E,0x33,0x30,0x18,0x0C,0x00,0x0C,0x00 }, // '?'
+        { 0x3E,0x63,0x7B,0x7B,0x7B,0x03,0x1E,0x00 }, // '@'
+        { 0x0C,0x1E,0x33,0x33,0x3F,0x33,0x33,0x00 }, // 'A'
+        { 0x3F,0x66,0x66,0x3E,0x66,0x66,0x3F,0x00 }, // 'B'
+        { 0x3C,0x66,0x03,0x03,0x03,0x66,0x3C,0x00 }, // 'C'
+        { 0x1F,0x36,0x66,0x66,0x66,0x36,0x1F,0x00 }, // 'D'
+        { 0x7F,0x46,0x16,0x1E,0x16,0x46,0x7F,0x00 }, // 'E'
+        { 0x7F,0x46,0x16,0x1E,0x16,0x06,0x0F,0x00 }, // 'F'
+        { 0x3C,0x66,0x03,0x03,0x73,0x66,0x7C,0x00 }, // 'G'
+        { 0x33,0x33,0x33,0x3F,0x33,0x33,0x33,0x00 }, // 'H'
+        { 0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00 }, // 'I'
+        { 0x78,0x30,0x30,0x30,0x33,0x33,0x1E,0x00 }, // 'J'
+        { 0x67,0x66,0x36,0x1E,0x36,0x66,0x67,0x00 }, // 'K'
+        { 0x0F,0x06,0x06,0x06,0x46,0x66,0x7F,0x00 }, // 'L'
+        { 0x63,0x77,0x7F,0x7F,0x6B,0x63,0x63,0x00 }, // 'M'
+        { 0x63,0x67,0x6F,0x7B,0x73,0x63,0x63,0x00 }, // 'N'
+        { 0x1C,0x36,0x63,0x63,0x63,0x36,0x1C,0x00 }, // 'O'
+        { 0x3F,0x66,0x66,0x3E,0x06,0x06,0x0F,0x00 }, // 'P'
+        { 0x1E,0x33,0x33,0x33,0x3B,0x1E,0x38,0x00 }, // 'Q'
+        { 0x3F,0x66,0x66,0x3E,0x36,0x66,0x67,0x00 }, // 'R'
+        { 0x1E,0x33,0x07,0x0E,0x38,0x33,0x1E,0x00 }, // 'S'
+        { 0x3F,0x2D,0x0C,0x0C,0x0C,0x0C,0x1E,0x00 }, // 'T'
+        { 0x33,0x33,0x33,0x33,0x33,0x33,0x3F,0x00 }, // 'U'
+        { 0x33,0x33,0x33,0x33,0x33,0x1E,0x0C,0x00 }, // 'V'
+        { 0x63,0x63,0x63,0x6B,0x7F,0x77,0x63,0x00 }, // 'W'
+        { 0x63,0x63,0x36,0x1C,0x1C,0x36,0x63,0x00 }, // 'X'
+        { 0x33,0x33,0x33,0x1E,0x0C,0x0C,0x1E,0x00 }, // 'Y'
+        { 0x7F,0x63,0x31,0x18,0x4C,0x66,0x7F,0x00 }, // 'Z'
+        { 0x1E,0x06,0x06,0x06,0x06,0x06,0x1E,0x00 }, // '['
+        { 0x03,0x06,0x0C,0x18,0x30,0x60,0x40,0x00 }, // '\\'
+        { 0x1E,0x18,0x18,0x18,0x18,0x18,0x1E,0x00 }, // ']'
+        { 0x08,0x1C,0x36,0x63,0x00,0x00,0x00,0x00 }, // '^'
+        { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF }, // '_'
+        { 0x0C,0x0C,0x18,0x00,0x00,0x00,0x00,0x00 }, // '`'
+        { 0x00,0x00,0x1E,0x30,0x3E,0x33,0x6E,0x00 }, // 'a'
+        { 0x07,0x06,0x06,0x3E,0x66,0x66,0x3B,0x00 }, // 'b'
+        { 0x00,0x00,0x1E,0x33,0x03,0x33,0x1E,0x00 }, // 'c'
+        { 0x38,0x30,0x30,0x3E,0x33,0x33,0x6E,0x00 }, // 'd'
+        { 0x00,0x00,0x1E,0x33,0x3F,0x03,0x1E,0x00 }, // 'e'
+        { 0x1C,0x36,0x06,0x0F,0x06,0x06,0x0F,0x00 }, // 'f'
+        { 0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x1F }, // 'g'
+        { 0x07,0x06,0x36,0x6E,0x66,0x66,0x67,0x00 }, // 'h'
+        { 0x0C,0x00,0x0E,0x0C,0x0C,0x0C,0x1E,0x00 }, // 'i'
+        { 0x30,0x00,0x30,0x30,0x30,0x33,0x33,0x1E }, // 'j'
+        { 0x07,0x06,0x66,0x36,0x1E,0x36,0x67,0x00 }, // 'k'
+        { 0x0E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00 }, // 'l'
+        { 0x00,0x00,0x33,0x7F,0x7F,0x6B,0x63,0x00 }, // 'm'
+        { 0x00,0x00,0x1F,0x33,0x33,0x33,0x33,0x00 }, // 'n'
+        { 0x00,0x00,0x1E,0x33,0x33,0x33,0x1E,0x00 }, // 'o'
+        { 0x00,0x00,0x3B,0x66,0x66,0x3E,0x06,0x0F }, // 'p'
+        { 0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x78 }, // 'q'
+        { 0x00,0x00,0x3B,0x6E,0x66,0x06,0x0F,0x00 }, // 'r'
+        { 0x00,0x00,0x3E,0x03,0x1E,0x30,0x1F,0x00 }, // 's'
+        { 0x08,0x0C,0x3E,0x0C,0x0C,0x2C,0x18,0x00 }, // 't'
+        { 0x00,0x00,0x33,0x33,0x33,0x33,0x6E,0x00 }, // 'u'
+        { 0x00,0x00,0x33,0x33,0x33,0x1E,0x0C,0x00 }, // 'v'
+        { 0x00,0x00,0x63,0x6B,0x7F,0x7F,0x36,0x00 }, // 'w'
+        { 0x00,0x00,0x63,0x36,0x1C,0x36,0x63,0x00 }, // 'x'
+        { 0x00,0x00,0x33,0x33,0x33,0x3E,0x30,0x1F }, // 'y'
+        { 0x00,0x00,0x3F,0x19,0x0C,0x26,0x3F,0x00 }, // 'z'
+        { 0x38,0x0C,0x0C,0x07,0x0C,0x0C,0x38,0x00 }, // '{'
+        { 0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x00 }, // '|'
+        { 0x07,0x0C,0x0C,0x38,0x0C,0x0C,0x07,0x00 }, // '}'
+        { 0x6E,0x3B,0x00,0x00,0x00,0x00,0x00,0x00 }, // '~'
+    };
+
+    constexpr int GLYPH_SIZE = 8;
+    constexpr int TEXT_SCALE = 2;  // Screen pixels per glyph pixel
+    constexpr int TEXT_MARGIN = 8; // Distance from the window edges
+
+} // namespace
+
+ConsoleOverlay::ConsoleOverlay() {
+    program = std::make_unique<Shader>("shaders/overlay.vert", "shaders/overlay.frag");
+
+    // Unit quad, (0,0)..(1,1); the vertex shader places it via u_rect.
+    float quadVertices[] = { 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f };
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glBindVertexArray(0);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+ConsoleOverlay::~ConsoleOverlay() {
+    glDeleteTextures(1, &texture);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+}
+
+void ConsoleOverlay::open(const std::string& promptText, std::function<void(const std::string&)> callback) {
+    prompt = promptText;
+    input.clear();
+    onSubmit = std::move(callback);
+    active = true;
+    textureDirty = true;
+}
+
+void ConsoleOverlay::onChar(unsigned int codepoint) {
+    if (!active) return;
+    if (codepoint >= 32 && codepoint < 127) { // The font covers printable ASCII
+        input.push_back(static_cast<char>(codepoint));
+        textureDirty = true;
+    }
+}
+
+bool ConsoleOverlay::onKey(int key) {
+    if (!active) return false;
+
+    switch (key) {
+    case GLFW_KEY_ENTER:
+    case GLFW_KEY_KP_ENTER: {
+        active = false;
+        // Move the callback out first: it may reopen the overlay.
+        auto callback = std::move(onSubmit);
+        if (callback) callback(input);
+        return true;
+    }
+    case GLFW_KEY_BACKSPACE:
+        if (!input.empty()) {
+            input.pop_back();
+            textureDirty = true;
+        }
+        return true;
+    case GLFW_KEY_ESCAPE:
+        active = false;
+        onSubmit = nullptr;
+        return true;
+    default:
+        return true; // Swallow everything else so hotkeys don't fire while typing
+    }
+}
+
+// Rasterizes prompt + input + cursor into a single-channel texture, one
+// glyph pixel per texel. A full line is ~1 KB, so just re-uploading on
+// every edit is far below the noise floor.
+void ConsoleOverlay::rebuildTexture() {
+    const std::string line = prompt + input + "_";
+    textureWidth = static_cast<int>(line.size()) * GLYPH_SIZE;
+    textureHeight = GLYPH_SIZE;
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(textureWidth) * textureHeight, 0);
+    for (size_t i = 0; i < line.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(line[i]);
+        if (c < 32 || c > 126) c = '?';
+        const unsigned char* glyph = FONT8X8[c - 32];
+        for (int row = 0; row < GLYPH_SIZE; ++row) {
+            for (int col = 0; col < GLYPH_SIZE; ++col) {
+                if ((glyph[row] >> col) & 1) {
+                    pixels[static_cast<size_t>(row) * textureWidth + i * GLYPH_SIZE + col] = 255;
+                }
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, textureWidth, textureHeight, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    textureDirty = false;
+}
+
+void ConsoleOverlay::draw(int windowWidth, int windowHeight) {
+    if (!active) return;
+    if (textureDirty) rebuildTexture();
+
+    // Bottom-left corner, in NDC.
+    float w = 2.0f * (textureWidth * TEXT_SCALE) / windowWidth;
+    float h = 2.0f * (textureHeight * TEXT_SCALE) / windowHeight;
+    float x = -1.0f + 2.0f * TEXT_MARGIN / windowWidth;
+    float y = -1.0f + 2.0f * TEXT_MARGIN / windowHeight;
+
+    program->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    program->setInt("u_text", 0);
+    program->setVec2("u_rectOrigin", x, y);
+    program->setVec2("u_rectSize", w, h);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+    glDisable(GL_BLEND);
+}
@@ -0,0 +1,51 @@
+// src/ConsoleOverlay.h
+// A one-line command overlay rendered on top of the board, replacing the
+// old blocking std::cin prompts. Opening it hands typed characters to an
+// edit line and the frame loop keeps running; Enter submits the line to a
+// callback, Escape cancels. Kiosk deployments have no console attached, so
+// nothing here may ever block on stdin.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <GL/glew.h>
+#include "Shader.h"
+
+class ConsoleOverlay {
+public:
+    ConsoleOverlay();
+    ~ConsoleOverlay();
+
+    // Shows the overlay with the given prompt. onSubmit receives the typed
+    // line (without the prompt) when the user presses Enter; it is not
+    // called on Escape.
+    void open(const std::string& prompt, std::function<void(const std::string&)> onSubmit);
+    bool isOpen() const { return active; }
+
+    // Feed from the GLFW character and key callbacks while open. onKey
+    // handles Enter, Backspace and Escape and returns true when consumed.
+    void onChar(unsigned int codepoint);
+    bool onKey(int key);
+
+    // Draws the prompt line along the bottom edge of the window. Cheap: the
+    // text bitmap is only recomposed when the line changed.
+    void draw(int windowWidth, int windowHeight);
+
+private:
+    void rebuildTexture();
+
+    bool active = false;
+    std::string prompt;
+    std::string input;
+    std::function<void(const std::string&)> onSubmit;
+
+    std::unique_ptr<Shader> program;
+    GLuint texture = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    int textureWidth = 0;  // In texels (8 per character)
+    int textureHeight = 0;
+    bool textureDirty = false;
+};
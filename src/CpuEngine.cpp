@@ -0,0 +1,175 @@
+// src/CpuEngine.cpp
+// Implementation of the bit-parallel CPU engine.
+//
+// Neighbor counting never touches individual cells: for each row the west and
+// east neighbor bitboards are built with cross-word shifts, then a bitwise
+// full-adder network sums the eight neighbor planes into ones/twos/fours bit
+// planes. Conway's rules reduce to:  next = twos & ~fours & (ones | alive).
+
+#include "CpuEngine.h"
+#include <bit>
+#include <random>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+CpuEngine::CpuEngine(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("CpuEngine: board dimensions must be positive");
+    }
+    W = ((width + 63) / 64) * 64; // Word-aligned width, exact toroidal wrap
+    H = height;
+    wordsPerRow = W / 64;
+    current.assign(static_cast<size_t>(wordsPerRow) * H, 0);
+    next.assign(current.size(), 0);
+}
+
+void CpuEngine::randomize(unsigned int seed) {
+    std::mt19937_64 gen(seed);
+    for (auto& word : current) {
+        word = gen(); // 64 independent fair coin flips per word
+    }
+}
+
+void CpuEngine::setCells(const std::vector<unsigned char>& cells) {
+    if (cells.size() != static_cast<size_t>(W) * H) {
+        throw std::runtime_error("CpuEngine::setCells: size mismatch");
+    }
+    std::fill(current.begin(), current.end(), 0);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (cells[static_cast<size_t>(y) * W + x]) {
+                current[static_cast<size_t>(y) * wordsPerRow + x / 64] |= (std::uint64_t(1) << (x % 64));
+            }
+        }
+    }
+}
+
+std::vector<unsigned char> CpuEngine::getCells() const {
+    std::vector<unsigned char> cells(static_cast<size_t>(W) * H);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            std::uint64_t word = current[static_cast<size_t>(y) * wordsPerRow + x / 64];
+            cells[static_cast<size_t>(y) * W + x] = (word >> (x % 64)) & 1u;
+        }
+    }
+    return cells;
+}
+
+unsigned long long CpuEngine::population() const {
+    unsigned long long count = 0;
+    for (std::uint64_t word : current) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+namespace {
+    // West neighbor plane: bit x holds cell x-1, wrapping across words and
+    // around the row ends (the row is a whole number of words).
+    inline void shiftWest(const std::uint64_t* row, std::uint64_t* out, int n) {
+        for (int k = 0; k < n; ++k) {
+            out[k] = (row[k] << 1) | (row[(k + n - 1) % n] >> 63);
+        }
+    }
+    // East neighbor plane: bit x holds cell x+1.
+    inline void shiftEast(const std::uint64_t* row, std::uint64_t* out, int n) {
+        for (int k = 0; k < n; ++k) {
+            out[k] = (row[k] >> 1) | (row[(k + 1) % n] << 63);
+        }
+    }
+}
+
+void CpuEngine::stepRow(int /*y*/, const std::uint64_t* above, const std::uint64_t* center,
+    const std::uint64_t* below, std::uint64_t* out) const {
+    const int n = wordsPerRow;
+
+    // Neighbor planes for the three source rows (stack buffers would not fit
+    // arbitrary widths, so these live per call; the compiler hoists well).
+    static thread_local std::vector<std::uint64_t> shifted;
+    shifted.resize(static_cast<size_t>(n) * 6);
+    std::uint64_t* aW = shifted.data();
+    std::uint64_t* aE = aW + n;
+    std::uint64_t* bW = aE + n;
+    std::uint64_t* bE = bW + n;
+    std::uint64_t* cW = bE + n;
+    std::uint64_t* cE = cW + n;
+    shiftWest(above, aW, n);  shiftEast(above, aE, n);
+    shiftWest(center, bW, n); shiftEast(center, bE, n);
+    shiftWest(below, cW, n);  shiftEast(below, cE, n);
+
+    int k = 0;
+
+#if defined(__AVX2__)
+    // Same boolean network as the scalar loop below, four words at a time.
+    for (; k + 4 <= n; k += 4) {
+        auto load = [](const std::uint64_t* p) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        };
+        __m256i al = load(&aW[k]), am = load(&above[k]), ar = load(&aE[k]);
+        __m256i bl = load(&bW[k]), bm = load(&center[k]), br = load(&bE[k]);
+        __m256i cl = load(&cW[k]), cm = load(&below[k]), cr = load(&cE[k]);
+
+        __m256i aOnes = _mm256_xor_si256(_mm256_xor_si256(al, am), ar);
+        __m256i aTwos = _mm256_or_si256(_mm256_and_si256(al, am),
+            _mm256_and_si256(_mm256_xor_si256(al, am), ar));
+        __m256i cOnes = _mm256_xor_si256(_mm256_xor_si256(cl, cm), cr);
+        __m256i cTwos = _mm256_or_si256(_mm256_and_si256(cl, cm),
+            _mm256_and_si256(_mm256_xor_si256(cl, cm), cr));
+        __m256i bOnes = _mm256_xor_si256(bl, br);
+        __m256i bTwos = _mm256_and_si256(bl, br);
+
+        __m256i ones = _mm256_xor_si256(_mm256_xor_si256(aOnes, bOnes), cOnes);
+        __m256i onesCarry = _mm256_or_si256(_mm256_and_si256(aOnes, bOnes),
+            _mm256_and_si256(_mm256_xor_si256(aOnes, bOnes), cOnes));
+        __m256i twosPartial = _mm256_xor_si256(_mm256_xor_si256(aTwos, bTwos), cTwos);
+        __m256i twosCarry = _mm256_or_si256(_mm256_and_si256(aTwos, bTwos),
+            _mm256_and_si256(_mm256_xor_si256(aTwos, bTwos), cTwos));
+        __m256i twos = _mm256_xor_si256(twosPartial, onesCarry);
+        __m256i fours = _mm256_or_si256(twosCarry, _mm256_and_si256(twosPartial, onesCarry));
+
+        __m256i alive = _mm256_and_si256(_mm256_andnot_si256(fours, twos),
+            _mm256_or_si256(ones, bm));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[k]), alive);
+    }
+#endif
+
+    for (; k < n; ++k) {
+        std::uint64_t al = aW[k], am = above[k], ar = aE[k];
+        std::uint64_t bl = bW[k], bm = center[k], br = bE[k];
+        std::uint64_t cl = cW[k], cm = below[k], cr = cE[k];
+
+        // Horizontal sums: three cells for the rows above/below, two for the
+        // center row (the cell itself is not its own neighbor).
+        std::uint64_t aOnes = al ^ am ^ ar;
+        std::uint64_t aTwos = (al & am) | ((al ^ am) & ar);
+        std::uint64_t cOnes = cl ^ cm ^ cr;
+        std::uint64_t cTwos = (cl & cm) | ((cl ^ cm) & cr);
+        std::uint64_t bOnes = bl ^ br;
+        std::uint64_t bTwos = bl & br;
+
+        // Vertical sum of the three (ones, twos) pairs.
+        std::uint64_t ones = aOnes ^ bOnes ^ cOnes;
+        std::uint64_t onesCarry = (aOnes & bOnes) | ((aOnes ^ bOnes) & cOnes);
+        std::uint64_t twosPartial = aTwos ^ bTwos ^ cTwos;
+        std::uint64_t twosCarry = (aTwos & bTwos) | ((aTwos ^ bTwos) & cTwos);
+        std::uint64_t twos = twosPartial ^ onesCarry;
+        // Any weight-4 carry means the count is >= 4, which is dead either
+        // way, so the fours plane only needs to be an OR.
+        std::uint64_t fours = twosCarry | (twosPartial & onesCarry);
+
+        out[k] = twos & ~fours & (ones | bm);
+    }
+}
+
+void CpuEngine::step() {
+    for (int y = 0; y < H; ++y) {
+        const std::uint64_t* above = &current[static_cast<size_t>((y + H - 1) % H) * wordsPerRow];
+        const std::uint64_t* center = &current[static_cast<size_t>(y) * wordsPerRow];
+        const std::uint64_t* below = &current[static_cast<size_t>((y + 1) % H) * wordsPerRow];
+        stepRow(y, above, center, below, &next[static_cast<size_t>(y) * wordsPerRow]);
+    }
+    current.swap(next);
+}
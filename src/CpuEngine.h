@@ -0,0 +1,39 @@
+// src/CpuEngine.h
+// A pure-CPU simulation engine for nodes without a GPU (CI, batch sweeps).
+// Rows are bit-packed into 64-bit words and neighbors are counted with a
+// bitwise full-adder network, so every machine word advances 64 cells at
+// once; with AVX2 the same network runs on 256-bit registers. No OpenGL,
+// GLFW or window is required anywhere in this class.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class CpuEngine {
+public:
+    // Width is rounded up to a multiple of 64 so the toroidal wrap stays
+    // exact at word granularity (same policy as the packed GPU board).
+    CpuEngine(int width, int height);
+
+    void randomize(unsigned int seed);
+    void step();                        // One generation, toroidal wrap
+
+    // Row-major 0/1 access, matching Renderer::readBoardCells/uploadBoardCells.
+    void setCells(const std::vector<unsigned char>& cells);
+    std::vector<unsigned char> getCells() const;
+
+    unsigned long long population() const;
+    int width() const { return W; }
+    int height() const { return H; }
+
+private:
+    void stepRow(int y, const std::uint64_t* above, const std::uint64_t* center,
+        const std::uint64_t* below, std::uint64_t* out) const;
+
+    int W;
+    int H;
+    int wordsPerRow;
+    std::vector<std::uint64_t> current;
+    std::vector<std::uint64_t> next;
+};
@@ -0,0 +1,100 @@
+// src/FrameExporter.cpp
+// Implementation of the background frame exporter.
+
+#include "FrameExporter.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+FrameExporter::FrameExporter(const std::string& dir) : directory(dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        throw std::runtime_error("Could not create frame export directory: " + directory);
+    }
+    for (int i = 0; i < WORKER_COUNT; ++i) {
+        workers.emplace_back(&FrameExporter::workerLoop, this);
+    }
+}
+
+FrameExporter::~FrameExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    std::cout << "Frame export: " << framesWritten << " frames written to "
+        << directory << ", " << framesDropped << " dropped (encoder backpressure)." << std::endl;
+}
+
+bool FrameExporter::enqueue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (jobs.size() >= MAX_QUEUED_JOBS) {
+            ++framesDropped;
+            return false;
+        }
+        jobs.push_back(std::move(job));
+    }
+    condition.notify_one();
+    return true;
+}
+
+void FrameExporter::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping and fully drained
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        writeFrame(job);
+        std::lock_guard<std::mutex> lock(mutex);
+        ++framesWritten;
+    }
+}
+
+// Writes one binary PGM (P5): 8-bit grayscale, top row first. GL readbacks
+// are bottom-to-top, so rows are emitted in reverse; packed boards fan each
+// R32UI word out to 32 pixels on the fly.
+void FrameExporter::writeFrame(const Job& job) const {
+    char name[64];
+    std::snprintf(name, sizeof(name), "frame_%09llu.pgm", job.generation);
+    const std::string path = directory + "/" + name;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Frame export: could not open " << path << std::endl;
+        return;
+    }
+    out << "P5\n" << job.width << ' ' << job.height << "\n255\n";
+
+    std::vector<unsigned char> row(job.width);
+    const int wordsPerRow = job.width / 32;
+    for (int y = job.height - 1; y >= 0; --y) {
+        if (job.packedWords) {
+            const unsigned char* words = job.data.data() + static_cast<size_t>(y) * wordsPerRow * 4;
+            for (int x = 0; x < job.width; ++x) {
+                unsigned int word = static_cast<unsigned int>(words[(x / 32) * 4])
+                    | (static_cast<unsigned int>(words[(x / 32) * 4 + 1]) << 8)
+                    | (static_cast<unsigned int>(words[(x / 32) * 4 + 2]) << 16)
+                    | (static_cast<unsigned int>(words[(x / 32) * 4 + 3]) << 24);
+                row[x] = ((word >> (x % 32)) & 1u) ? 255 : 0;
+            }
+        }
+        else {
+            const unsigned char* cells = job.data.data() + static_cast<size_t>(y) * job.width;
+            for (int x = 0; x < job.width; ++x) {
+                row[x] = cells[x];
+            }
+        }
+        out.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+}
@@ -0,0 +1,53 @@
+// src/FrameExporter.h
+// Background frame encoder for timelapse recording. The render thread hands
+// raw board readbacks to enqueue(); a pool of worker threads writes them as
+// a numbered PGM image sequence (binary grayscale, zero dependencies, and
+// any video encoder ingests it: ffmpeg -i frame_%09llu.pgm). The queue is
+// bounded: when the encoders fall behind, enqueue() drops the frame and
+// counts it instead of stalling the GL thread.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FrameExporter {
+public:
+    struct Job {
+        unsigned long long generation; // Becomes the frame's file name
+        int width;                     // Logical grid width in cells
+        int height;
+        bool packedWords;              // Data is R32UI words (32 cells each)
+        std::vector<unsigned char> data;
+    };
+
+    // Frames are written into `directory` (created if missing; throws
+    // std::runtime_error when that fails).
+    explicit FrameExporter(const std::string& directory);
+    ~FrameExporter(); // Drains the queue, then prints written/dropped totals
+
+    // Returns false (and counts a drop) when the queue is saturated.
+    bool enqueue(Job job);
+
+private:
+    void workerLoop();
+    void writeFrame(const Job& job) const;
+
+    // Two encoders overlap file writes with the next frame's readback; the
+    // queue cap keeps worst-case memory at a handful of frames.
+    static constexpr int WORKER_COUNT = 2;
+    static constexpr size_t MAX_QUEUED_JOBS = 8;
+
+    std::string directory;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Job> jobs;
+    bool stopping = false;
+    unsigned long long framesWritten = 0;
+    unsigned long long framesDropped = 0;
+    std::vector<std::thread> workers;
+};
@@ -2,14 +2,32 @@
 // Implementation of the main GameOfLife application class.
 
 #include "GameOfLife.h"
+#include "PatternLoader.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
 #include <iostream>
+#include <random>
 #include <stdexcept>
-#include <limits>
+#include <sstream>
+
+// Timestamped filename for manual checkpoints, e.g. checkpoint_20260901_143015.golc
+static std::string makeSnapshotPath() {
+    std::time_t now = std::time(nullptr);
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), "checkpoint_%Y%m%d_%H%M%S.golc", std::localtime(&now));
+    return buffer;
+}
+
+GameOfLife::GameOfLife(int winWidth, int winHeight, int grdWidth, int grdHeight, const std::string& title, const AppConfig& cfg)
+    : windowWidth(winWidth), windowHeight(winHeight), gridWidth(grdWidth), gridHeight(grdHeight), config(cfg), window(nullptr) {
 
-GameOfLife::GameOfLife(int winWidth, int winHeight, int grdWidth, int grdHeight, const std::string& title)
-    : windowWidth(winWidth), windowHeight(winHeight), gridWidth(grdWidth), gridHeight(grdHeight), window(nullptr) {
+    if (config.benchmark) {
+        gridWidth = config.benchWidth;
+        gridHeight = config.benchHeight;
+    }
 
     initWindow(title);
 
@@ -17,11 +35,61 @@ GameOfLife::GameOfLife(int winWidth, int winHeight, int grdWidth, int grdHeight,
         throw std::runtime_error("Failed to initialize GLEW");
     }
 
-    renderer = std::make_unique<Renderer>(window, windowWidth, windowHeight, gridWidth, gridHeight);
+    if (config.batchCount > 0) {
+        // Batch mode needs none of the interactive machinery: no renderer,
+        // no input handling, no overlay. The context is all it shares.
+        batchRunner = std::make_unique<BatchRunner>(config.batchCount,
+            config.batchWidth, config.batchHeight,
+            config.hasSeed ? config.seed : std::random_device{}(), config.rule);
+        return;
+    }
+
+    renderer = std::make_unique<Renderer>(window, windowWidth, windowHeight, gridWidth, gridHeight, config.packedBoard, config.useCompute, config.rule);
     inputHandler = std::make_unique<InputHandler>(window, *renderer);
 
     inputHandler->setupCallbacks();
 
+    if (!config.benchmark) {
+        console = std::make_unique<ConsoleOverlay>();
+        inputHandler->setConsoleOverlay(console.get());
+    }
+
+    if (!config.exportDir.empty() && config.exportEvery > 0) {
+        renderer->startFrameExport(config.exportDir, config.exportEvery);
+    }
+
+    if (!config.recordLogPath.empty()) {
+        renderer->startMutationLog(config.recordLogPath);
+    }
+    if (!config.replayLogPath.empty()) {
+        replayLog = MutationLog::load(config.replayLogPath); // Throws on bad logs
+        std::cout << "Replaying " << replayLog.size() << " mutations from "
+            << config.replayLogPath << "." << std::endl;
+    }
+
+    if (config.autoStop) {
+        renderer->enableAutoStop();
+    }
+
+    if (config.threaded && !config.benchmark) {
+        renderer->startThreadedSimulation();
+    }
+
+    simTimer = std::make_unique<GpuTimer>();
+    drawTimer = std::make_unique<GpuTimer>();
+    if (!config.timingLogPath.empty()) {
+        timingLog.open(config.timingLogPath);
+        if (timingLog.is_open()) {
+            timingLog << "wall_time,fps,sim_ms,draw_ms\n";
+            std::cout << "Logging GPU timings to " << config.timingLogPath << std::endl;
+        }
+        else {
+            std::cerr << "Could not open timing log " << config.timingLogPath << std::endl;
+        }
+    }
+
+    if (config.benchmark) return; // No interactive controls in benchmark mode
+
     std::cout << "--- Controls ---\n"
         << "SPACE: Pause/Resume\n"
         << "Left Mouse: Draw cells (or place glider)\n"
@@ -35,6 +103,14 @@ GameOfLife::GameOfLife(int winWidth, int winHeight, int grdWidth, int grdHeight,
         << "K: Toggle Simulation Speed Limit\n"
         << "Up/Down Arrows: Increase/Decrease Sim Speed\n"
         << "S: Set Specific Sim Speed\n"
+        << "P: Load .rle pattern file\n"
+        << "A: Toggle activity tracking (skip static regions)\n"
+        << "D: Toggle fused double-step kernel (2 generations/pass)\n"
+        << "O: Save a checkpoint to disk (asynchronous)\n"
+        << "F9: Load a checkpoint (.golc)\n"
+        << "J: Jump N generations ahead (HashLife)\n"
+        << "[ / ]: Shrink/Grow the draw brush\n"
+        << ".: Step only the visible region (paused inspection)\n"
         << "G: Toggle Glider Mode\n"
         << "T: Rotate Glider (in Glider Mode)\n"
         << "ESC: Exit\n"
@@ -53,11 +129,24 @@ void GameOfLife::initWindow(const std::string& title) {
         throw std::runtime_error("Failed to initialize GLFW");
     }
 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    // The compute engine needs a 4.3 context; everything else runs on 3.3.
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, config.useCompute ? 4 : 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (config.benchmark || config.batchCount > 0) {
+        // Benchmark and batch runs are offscreen: create the context
+        // without showing a window.
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
 
     window = glfwCreateWindow(windowWidth, windowHeight, title.c_str(), nullptr, nullptr);
+    if (!window && config.useCompute) {
+        // Driver can't give us 4.3 - retry with 3.3 and let the renderer
+        // fall back to the fragment path.
+        std::cout << "OpenGL 4.3 context unavailable; retrying with 3.3." << std::endl;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        window = glfwCreateWindow(windowWidth, windowHeight, title.c_str(), nullptr, nullptr);
+    }
     if (!window) {
         glfwTerminate();
         throw std::runtime_error("Failed to create GLFW window");
@@ -75,32 +164,160 @@ void GameOfLife::onWindowResize(int width, int height) {
 
 
 void GameOfLife::run() {
-    renderer->randomizeBoard();
-    mainLoop();
+    if (batchRunner) {
+        glfwSwapInterval(0); // Nothing is presented; don't let V-Sync pace the loop
+        batchRunner->run(config.batchGenerations);
+        return;
+    }
+    if (config.hasSeed) {
+        renderer->randomizeBoard(config.seed);
+    }
+    else {
+        renderer->randomizeBoard();
+    }
+    if (config.benchmark) {
+        runBenchmark();
+    }
+    else {
+        mainLoop();
+    }
+}
+
+// Runs config.benchGenerations simulation steps back-to-back (no drawing, no
+// swap) and reports throughput. V-Sync is disabled so nothing throttles the
+// submission rate; a GL_TIME_ELAPSED query measures actual GPU time.
+void GameOfLife::runBenchmark() {
+    const int generations = config.benchGenerations;
+    std::cout << "Benchmark: " << gridWidth << "x" << gridHeight << " grid, "
+        << generations << " generations"
+        << (config.packedBoard ? ", packed board" : "")
+        << (config.useCompute ? ", compute engine" : "") << std::endl;
+
+    glfwSwapInterval(0);
+
+    // Warm up: let the driver compile/specialize everything off the clock.
+    for (int i = 0; i < 10; ++i) {
+        applyDueReplayMutations();
+        renderer->runSimulationStep();
+    }
+    glFinish();
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+
+    double wallStart = glfwGetTime();
+    int generationsRun = 0;
+    for (int i = 0; i < generations; ++i) {
+        applyDueReplayMutations();
+        renderer->runSimulationStep();
+        ++generationsRun;
+        // With --auto-stop there is no point burning GPU time past the
+        // moment the board settles; the throughput report still holds.
+        if (renderer->boardStabilized()) {
+            std::cout << "Auto-stop: ending the run after " << generationsRun
+                << " of " << generations << " generations." << std::endl;
+            break;
+        }
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glFinish();
+    double wallSeconds = glfwGetTime() - wallStart;
+
+    GLuint64 gpuNanos = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &gpuNanos);
+    glDeleteQueries(1, &query);
+
+    const double cells = static_cast<double>(gridWidth) * gridHeight;
+    const double generationsPerSec = generationsRun / wallSeconds;
+    std::cout << "Wall time:        " << wallSeconds * 1000.0 << " ms\n"
+        << "Generations/sec:  " << generationsPerSec << "\n"
+        << "Cell-updates/sec: " << generationsPerSec * cells << "\n"
+        << "GPU time/step:    " << (gpuNanos / 1e6) / generationsRun << " ms" << std::endl;
 }
 
 void GameOfLife::mainLoop() {
     lastTime = glfwGetTime();
-    timeOfLastUpdate = lastTime; // Initialize the last update time
+    previousFrameTime = lastTime;
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         processInput();
 
         double currentTime = glfwGetTime();
-
-        // --- This is the new speed control logic ---
-        // Only run a simulation step if the game is not paused AND
-        // if enough time has passed since the last update.
-        if (!isPaused) {
-            if (!limitSpeed || (currentTime - timeOfLastUpdate >= 1.0 / updatesPerSecond)) {
+        double frameDelta = currentTime - previousFrameTime;
+        previousFrameTime = currentTime;
+
+        // --- Fixed-timestep accumulator ---
+        // The configured rate is honored independently of render FPS: each
+        // frame banks the elapsed time and runs however many steps that time
+        // is worth, back-to-back, with no draw or state read in between.
+        // Previously at most one step ran per frame, so V-Sync silently
+        // capped the simulation at the display refresh rate.
+        simTimer->begin();
+        if (renderer->threadedSimulation()) {
+            // The worker thread steps continuously on its own context; just
+            // forward the pause state and keep no accumulator debt here.
+            renderer->setSimulationPaused(isPaused);
+            simTimeAccumulator = 0.0;
+        }
+        else if (!isPaused) {
+            if (!limitSpeed) {
+                // Unlimited: one step per rendered frame, as fast as we draw.
+                applyDueReplayMutations();
                 renderer->runSimulationStep();
-                timeOfLastUpdate = currentTime; // Record the time of this update
+                simTimeAccumulator = 0.0;
+            }
+            else {
+                simTimeAccumulator += frameDelta;
+
+                // If rendering can't keep up with the configured rate, drop
+                // the backlog instead of spiraling (never owe more than one
+                // second of simulation).
+                simTimeAccumulator = std::min(simTimeAccumulator, 1.0);
+
+                const double stepInterval = 1.0 / updatesPerSecond;
+                while (simTimeAccumulator >= stepInterval) {
+                    applyDueReplayMutations();
+                    // When two or more steps are owed, the fused kernel pays
+                    // them off two at a time in a single pass. Single steps
+                    // while replaying, so mutations land on exact generations.
+                    if (replayLog.empty() && renderer->canDoubleStep() && simTimeAccumulator >= 2.0 * stepInterval) {
+                        renderer->runSimulationDoubleStep();
+                        simTimeAccumulator -= 2.0 * stepInterval;
+                    }
+                    else {
+                        renderer->runSimulationStep();
+                        simTimeAccumulator -= stepInterval;
+                    }
+                }
             }
         }
+        else {
+            simTimeAccumulator = 0.0; // Don't bank time while paused
+        }
+        simTimer->end();
+
+        // Auto-stop: the detector latches once the board settles; pause and
+        // hand control back (Space resumes and re-arms it).
+        if (renderer->boardStabilized() && !isPaused) {
+            isPaused = true;
+            std::cout << "Auto-stop: simulation paused." << std::endl;
+        }
+
+        // Keep the population counter ticking over (asynchronous, never stalls)
+        if (!isPaused) {
+            renderer->updateStatistics();
+        }
+
+        // Hand any finished snapshot readbacks to the writer thread
+        renderer->pollSnapshots();
 
         // Drawing to the screen still happens every frame
+        drawTimer->begin();
         renderer->drawToScreen();
+        drawTimer->end();
+        if (console) console->draw(windowWidth, windowHeight);
         glfwSwapBuffers(window);
 
         // The FPS counter is now separate from the simulation speed
@@ -108,51 +325,96 @@ void GameOfLife::mainLoop() {
     }
 }
 
-void GameOfLife::promptAndResizeGrid() {
-    isPaused = true; // Pause the simulation while we get input
-    std::cout << "\n--- Grid Resize ---\nSimulation paused. Please enter new grid dimensions in the console.\n"
-        << "(width height): ";
-
-    int newWidth = 0, newHeight = 0;
-    std::cin >> newWidth >> newHeight;
+// The prompts below open the in-window console overlay and return
+// immediately; the frame loop keeps running (and rendering) while the user
+// types. The submitted line is parsed in the callback when Enter is
+// pressed. Nothing here touches std::cin: kiosk deployments have no
+// console attached, and blocking on it used to hang the app permanently.
 
-    if (std::cin.good() && newWidth > 0 && newHeight > 0) {
-        // THE FIX: Update the GameOfLife object's own grid dimension variables.
-        this->gridWidth = newWidth;
-        this->gridHeight = newHeight;
-
-        // Now, command the renderer to perform the resize.
-        renderer->resizeGrid(newWidth, newHeight);
+void GameOfLife::promptAndResizeGrid() {
+    isPaused = true; // Pause the simulation while the overlay is up
+    console->open("New grid (width height [corner]): ", [this](const std::string& line) {
+        std::istringstream in(line);
+        int newWidth = 0, newHeight = 0;
+        if (!(in >> newWidth >> newHeight) || newWidth <= 0 || newHeight <= 0) {
+            std::cout << "Invalid input. Please enter two positive numbers." << std::endl;
+            return;
+        }
+        // Optional placement keyword on the rest of the line; the current
+        // board is preserved, centered by default or anchored bottom-left.
+        std::string rest;
+        std::getline(in, rest);
+        bool corner = rest.find("corner") != std::string::npos;
+
+        gridWidth = newWidth;
+        gridHeight = newHeight;
+        renderer->resizeGrid(newWidth, newHeight, corner);
         std::cout << "Grid resized. Press Space to resume simulation." << std::endl;
-    }
-    else {
-        std::cout << "Invalid input. Please enter two positive numbers." << std::endl;
-        // Clear error flags and ignore the rest of the bad input line
-        std::cin.clear();
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    }
+    });
 }
 
 void GameOfLife::promptAndSetSpeed() {
-    isPaused = true; // Pause while we get input
-    std::cout << "\n--- Set Speed ---\nSimulation paused. Please enter a new speed in the console.\n"
-        << "(Updates Per Second): ";
-
-    double newSpeed = 0.0;
-    std::cin >> newSpeed;
-
-    // Validate the user's input
-    if (std::cin.good() && newSpeed > 0) {
+    isPaused = true; // Pause while the overlay is up
+    console->open("Updates per second: ", [this](const std::string& line) {
+        std::istringstream in(line);
+        double newSpeed = 0.0;
+        if (!(in >> newSpeed) || newSpeed <= 0) {
+            std::cout << "Invalid input. Please enter a positive number." << std::endl;
+            return;
+        }
         updatesPerSecond = newSpeed;
         limitSpeed = true; // Re-enable the limit to use the new speed
         std::cout << "Simulation speed set to " << updatesPerSecond << " UPS. Press Space to resume simulation" << std::endl;
-    }
-    else {
-        std::cout << "Invalid input. Please enter a positive number." << std::endl;
-        // Clear error flags and ignore the rest of the bad input line
-        std::cin.clear();
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    }
+    });
+}
+
+void GameOfLife::promptAndLoadPattern() {
+    isPaused = true; // Pause while the overlay is up
+    console->open("Pattern file (.rle): ", [this](const std::string& line) {
+        if (line.empty()) {
+            std::cout << "Invalid input." << std::endl;
+            return;
+        }
+        try {
+            Pattern pattern = PatternLoader::load(line);
+            renderer->stampPattern(gridWidth / 2, gridHeight / 2, pattern);
+            std::cout << "Pattern placed at the board center. Press Space to resume simulation." << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cout << "Failed to load pattern: " << e.what() << std::endl;
+        }
+    });
+}
+
+void GameOfLife::promptAndLoadCheckpoint() {
+    isPaused = true; // Pause while the overlay is up
+    console->open("Checkpoint file (.golc): ", [this](const std::string& line) {
+        if (line.empty()) {
+            std::cout << "Invalid input." << std::endl;
+            return;
+        }
+        try {
+            renderer->loadCheckpoint(line);
+            std::cout << "Press Space to resume simulation." << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cout << "Failed to load checkpoint: " << e.what() << std::endl;
+        }
+    });
+}
+
+void GameOfLife::promptAndSkipGenerations() {
+    isPaused = true; // HashLife takes over; the GPU stepper stays paused
+    console->open("Generations to skip (HashLife): ", [this](const std::string& line) {
+        std::istringstream in(line);
+        unsigned long long generations = 0;
+        if (!(in >> generations) || generations == 0) {
+            std::cout << "Invalid input. Please enter a positive number." << std::endl;
+            return;
+        }
+        renderer->skipGenerations(generations);
+        std::cout << "Press Space to resume simulation." << std::endl;
+    });
 }
 
 void GameOfLife::processInput() {
@@ -176,12 +438,26 @@ void GameOfLife::processInput() {
     if (inputHandler->wasKeyPressed(GLFW_KEY_N)) {
         promptAndResizeGrid();
     }
+    if (inputHandler->wasKeyPressed(GLFW_KEY_P)) {
+        promptAndLoadPattern();
+    }
+    if (inputHandler->wasKeyPressed(GLFW_KEY_J)) {
+        promptAndSkipGenerations();
+    }
     if (inputHandler->wasKeyPressed(GLFW_KEY_SPACE)) {
         isPaused = !isPaused;
+        if (!isPaused) renderer->resetStabilization(); // Re-arm auto-stop on resume
         std::cout << (isPaused ? "Paused" : "Resumed") << std::endl;
     }
+    if (inputHandler->wasKeyPressed(GLFW_KEY_PERIOD) && isPaused) renderer->stepVisibleRegion();
+    if (inputHandler->wasKeyPressed(GLFW_KEY_A)) renderer->toggleActivityTracking();
+    if (inputHandler->wasKeyPressed(GLFW_KEY_D)) renderer->toggleFusedKernel();
+    if (inputHandler->wasKeyPressed(GLFW_KEY_O)) renderer->requestSnapshot(makeSnapshotPath());
+    if (inputHandler->wasKeyPressed(GLFW_KEY_F9)) promptAndLoadCheckpoint();
     if (inputHandler->wasKeyPressed(GLFW_KEY_C)) renderer->clearBoard();
     if (inputHandler->wasKeyPressed(GLFW_KEY_R)) renderer->randomizeBoard();
+    if (inputHandler->wasKeyPressed(GLFW_KEY_LEFT_BRACKET)) renderer->adjustBrushSize(-1);
+    if (inputHandler->wasKeyPressed(GLFW_KEY_RIGHT_BRACKET)) renderer->adjustBrushSize(1);
     if (inputHandler->wasKeyPressed(GLFW_KEY_G)) inputHandler->toggleGliderMode();
     if (inputHandler->wasKeyPressed(GLFW_KEY_T)) inputHandler->rotateGlider();
 
@@ -191,12 +467,39 @@ void GameOfLife::processInput() {
         inputHandler->getGliderRotation());
 }
 
+void GameOfLife::applyDueReplayMutations() {
+    while (replayPos < replayLog.size()
+        && replayLog[replayPos].generation <= renderer->getGeneration()) {
+        renderer->applyMutation(replayLog[replayPos]);
+        ++replayPos;
+    }
+}
+
 void GameOfLife::updateFpsCounter() {
     double currentTime = glfwGetTime();
     frameCount++;
     if (currentTime - lastTime >= 1.0) {
         std::string title = "GPU Conway's Game of Life | FPS: " + std::to_string(frameCount) + " | " + (isPaused ? "Paused" : "Running");
+        if (renderer->getPopulation() >= 0) {
+            long long delta = renderer->getPopulationDelta();
+            title += " | Pop: " + std::to_string(renderer->getPopulation())
+                + " (" + (delta >= 0 ? "+" : "") + std::to_string(delta) + ")";
+        }
+
+        // Per-stage GPU timings (rolling averages, collected without stalls)
+        char timings[64];
+        std::snprintf(timings, sizeof(timings), " | Sim: %.2f ms | Draw: %.2f ms",
+            simTimer->averageMs(), drawTimer->averageMs());
+        title += timings;
+
         glfwSetWindowTitle(window, title.c_str());
+
+        if (timingLog.is_open()) {
+            timingLog << currentTime << ',' << frameCount << ','
+                << simTimer->averageMs() << ',' << drawTimer->averageMs() << '\n';
+            timingLog.flush();
+        }
+
         frameCount = 0;
         lastTime = currentTime;
     }
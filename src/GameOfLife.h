@@ -6,41 +6,76 @@
 
 #include <string>
 #include <memory>
+#include <fstream>
+#include "AppConfig.h"
+#include "BatchRunner.h"
 #include "Renderer.h"
 #include "InputHandler.h"
+#include "ConsoleOverlay.h"
+#include "GpuTimer.h"
+#include "MutationLog.h"
+#include <vector>
 
 struct GLFWwindow;
 
 class GameOfLife {
 public:
-    GameOfLife(int windowWidth, int windowHeight, int gridWidth, int gridHeight, const std::string& title);
+    GameOfLife(int windowWidth, int windowHeight, int gridWidth, int gridHeight, const std::string& title, const AppConfig& config = {});
     ~GameOfLife();
     void run();
 
 private:
     void initWindow(const std::string& title);
     void mainLoop();
+    void runBenchmark();
     void updateFpsCounter();
     void processInput();
     void onWindowResize(int width, int height);
     void promptAndResizeGrid();
     void promptAndSetSpeed();
+    void promptAndLoadPattern();
+    void promptAndLoadCheckpoint();
+    void promptAndSkipGenerations();
+
+    // Applies every replayed mutation that is due at or before the current
+    // generation. Called right before each simulation step.
+    void applyDueReplayMutations();
 
     int windowWidth;
     int windowHeight;
     int gridWidth;
     int gridHeight;
+    AppConfig config;
 
     GLFWwindow* window;
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<InputHandler> inputHandler;
 
+    // Ensemble batch mode (--batch) replaces the renderer entirely: the
+    // window stays hidden and run() hands over to the batch runner.
+    std::unique_ptr<BatchRunner> batchRunner;
+
+    // In-window command line for the N/S/P/J/F9 prompts. The frame loop
+    // keeps running while it is open; nothing ever blocks on stdin (kiosk
+    // deployments have no console attached). Null in benchmark mode.
+    std::unique_ptr<ConsoleOverlay> console;
+
+    // Per-stage GPU timing (double-buffered queries, never stall)
+    std::unique_ptr<GpuTimer> simTimer;
+    std::unique_ptr<GpuTimer> drawTimer;
+    std::ofstream timingLog;
+
     bool isPaused = false;
 
+    // Loaded --replay log, consumed front to back as generations pass
+    std::vector<Mutation> replayLog;
+    size_t replayPos = 0;
+
     double lastTime = 0.0;
     int frameCount = 0;
 
     bool limitSpeed = true;
     double updatesPerSecond = 30.0;
-    double timeOfLastUpdate = 0.0;
+    double previousFrameTime = 0.0;
+    double simTimeAccumulator = 0.0;
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+// src/GpuTimer.cpp
+// Implementation of the double-buffered GPU timer.
+
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer() {
+    glGenQueries(2, queries);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(2, queries);
+}
+
+void GpuTimer::begin() {
+    // Collect the other query's result if the GPU has finished with it.
+    // Checking availability first means this never blocks.
+    int readIndex = 1 - writeIndex;
+    if (pending[readIndex]) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(queries[readIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 elapsedNs = 0;
+            glGetQueryObjectui64v(queries[readIndex], GL_QUERY_RESULT, &elapsedNs);
+            pending[readIndex] = false;
+
+            // Exponential rolling average; seeded with the first sample.
+            if (!haveSample) {
+                averageNs = static_cast<double>(elapsedNs);
+                haveSample = true;
+            }
+            else {
+                averageNs += 0.05 * (static_cast<double>(elapsedNs) - averageNs);
+            }
+        }
+    }
+
+    // Start this frame's measurement, unless the slot is still in flight
+    // (then this frame simply goes unmeasured rather than stalling).
+    if (!pending[writeIndex]) {
+        glBeginQuery(GL_TIME_ELAPSED, queries[writeIndex]);
+        active = true;
+    }
+}
+
+void GpuTimer::end() {
+    if (!active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    pending[writeIndex] = true;
+    writeIndex = 1 - writeIndex;
+    active = false;
+}
@@ -0,0 +1,30 @@
+// src/GpuTimer.h
+// Non-blocking GPU stage timer built on GL_TIME_ELAPSED queries. Two queries
+// are rotated so results are collected a frame late instead of stalling the
+// pipeline; averageMs() exposes a rolling average of recent samples.
+
+#pragma once
+
+#include <GL/glew.h>
+
+class GpuTimer {
+public:
+    GpuTimer();
+    ~GpuTimer();
+
+    // Bracket the GL commands of one stage for this frame. begin() also
+    // collects any finished result from a previous frame (never waits).
+    void begin();
+    void end();
+
+    // Rolling average GPU time of the bracketed stage, in milliseconds.
+    double averageMs() const { return averageNs / 1e6; }
+
+private:
+    GLuint queries[2] = { 0, 0 };
+    bool pending[2] = { false, false };
+    int writeIndex = 0;
+    bool active = false;   // True between begin() and end() when a query was issued
+    double averageNs = 0.0;
+    bool haveSample = false;
+};
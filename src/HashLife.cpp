@@ -0,0 +1,279 @@
+// src/HashLife.cpp
+// Implementation of the HashLife engine. The algorithm follows Gosper's
+// scheme: every distinct subtree exists exactly once (hash consing), and the
+// "advance the center of this node by 2^j generations" function is memoized
+// per (node, j), which is where the exponential speedup comes from.
+
+#include "HashLife.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // Boost-style hash combining for pointer-sized values.
+    inline std::size_t hashCombine(std::size_t seed, std::size_t value) {
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+}
+
+std::size_t HashLife::NodeKeyHash::operator()(const NodeKey& k) const {
+    size_t h = std::hash<void*>()(k.nw);
+    h = hashCombine(h, std::hash<void*>()(k.ne));
+    h = hashCombine(h, std::hash<void*>()(k.sw));
+    h = hashCombine(h, std::hash<void*>()(k.se));
+    return h;
+}
+
+std::size_t HashLife::StepKeyHash::operator()(const StepKey& k) const {
+    return hashCombine(std::hash<void*>()(k.node), std::hash<int>()(k.j));
+}
+
+HashLife::HashLife() {
+    pool.push_back({ nullptr, nullptr, nullptr, nullptr, 0, 0 });
+    deadLeaf = &pool.back();
+    pool.push_back({ nullptr, nullptr, nullptr, nullptr, 1, 0 });
+    aliveLeaf = &pool.back();
+}
+
+HashLife::Node* HashLife::makeLeaf(bool alive) {
+    return alive ? aliveLeaf : deadLeaf;
+}
+
+HashLife::Node* HashLife::makeNode(Node* nw, Node* ne, Node* sw, Node* se) {
+    NodeKey key{ nw, ne, sw, se };
+    auto it = internTable.find(key);
+    if (it != internTable.end()) {
+        return it->second;
+    }
+    pool.push_back({ nw, ne, sw, se,
+        nw->population + ne->population + sw->population + se->population,
+        nw->level + 1 });
+    Node* node = &pool.back();
+    internTable.emplace(key, node);
+    return node;
+}
+
+HashLife::Node* HashLife::emptyNode(int level) {
+    if (level < static_cast<int>(emptyByLevel.size())) {
+        return emptyByLevel[level];
+    }
+    while (static_cast<int>(emptyByLevel.size()) <= level) {
+        if (emptyByLevel.empty()) {
+            emptyByLevel.push_back(deadLeaf);
+        }
+        else {
+            Node* e = emptyByLevel.back();
+            emptyByLevel.push_back(makeNode(e, e, e, e));
+        }
+    }
+    return emptyByLevel[level];
+}
+
+HashLife::Node* HashLife::centeredSub(Node* n) {
+    return makeNode(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+HashLife::Node* HashLife::expand(Node* n) {
+    Node* e = emptyNode(n->level - 1);
+    return makeNode(
+        makeNode(e, e, e, n->nw),
+        makeNode(e, e, n->ne, e),
+        makeNode(e, n->sw, e, e),
+        makeNode(n->se, e, e, e));
+}
+
+// One generation of the 2x2 center of a 4x4 (level-2) node, by direct rule
+// evaluation. This is the recursion's base case.
+HashLife::Node* HashLife::baseStep(Node* n) {
+    // Unpack the 4x4 into a bitmap: bit (y * 4 + x), y = 0 is the top row.
+    auto leafBit = [](const Node* quad, int x, int y) -> int {
+        const Node* half = (y == 0) ? ((x == 0) ? quad->nw : quad->ne)
+                                    : ((x == 0) ? quad->sw : quad->se);
+        return static_cast<int>(half->population);
+    };
+    int grid[4][4];
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const Node* quad = (y < 2) ? ((x < 2) ? n->nw : n->ne)
+                                       : ((x < 2) ? n->sw : n->se);
+            grid[y][x] = leafBit(quad, x & 1, y & 1);
+        }
+    }
+
+    Node* cells[2][2];
+    for (int y = 1; y <= 2; ++y) {
+        for (int x = 1; x <= 2; ++x) {
+            int neighbors = 0;
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                    neighbors += grid[y + dy][x + dx];
+            neighbors -= grid[y][x];
+            bool alive = grid[y][x]
+                ? (neighbors == 2 || neighbors == 3)
+                : (neighbors == 3);
+            cells[y - 1][x - 1] = makeLeaf(alive);
+        }
+    }
+    return makeNode(cells[0][0], cells[0][1], cells[1][0], cells[1][1]);
+}
+
+// Returns the center of n advanced by 2^j generations (j <= n->level - 2).
+HashLife::Node* HashLife::step(Node* n, int j) {
+    if (n->population == 0) {
+        return emptyNode(n->level - 1);
+    }
+    if (n->level == 2) {
+        return baseStep(n); // j is necessarily 0 here
+    }
+
+    StepKey key{ n, j };
+    auto it = stepCache.find(key);
+    if (it != stepCache.end()) {
+        return it->second;
+    }
+
+    // The nine overlapping level-1 subsquares of n.
+    Node* n00 = n->nw;
+    Node* n01 = makeNode(n->nw->ne, n->ne->nw, n->nw->se, n->ne->sw);
+    Node* n02 = n->ne;
+    Node* n10 = makeNode(n->nw->sw, n->nw->se, n->sw->nw, n->sw->ne);
+    Node* n11 = centeredSub(n);
+    Node* n12 = makeNode(n->ne->sw, n->ne->se, n->se->nw, n->se->ne);
+    Node* n20 = n->sw;
+    Node* n21 = makeNode(n->sw->ne, n->se->nw, n->sw->se, n->se->sw);
+    Node* n22 = n->se;
+
+    // Superspeed (j == level - 2): both halves of the jump are recursive
+    // steps. Otherwise the first layer just extracts centers so that the
+    // whole 2^j advance happens in the second layer.
+    const bool superspeed = (j == n->level - 2);
+    Node* t00, * t01, * t02, * t10, * t11, * t12, * t20, * t21, * t22;
+    if (superspeed) {
+        int half = n->level - 3;
+        t00 = step(n00, half); t01 = step(n01, half); t02 = step(n02, half);
+        t10 = step(n10, half); t11 = step(n11, half); t12 = step(n12, half);
+        t20 = step(n20, half); t21 = step(n21, half); t22 = step(n22, half);
+    }
+    else {
+        t00 = centeredSub(n00); t01 = centeredSub(n01); t02 = centeredSub(n02);
+        t10 = centeredSub(n10); t11 = centeredSub(n11); t12 = centeredSub(n12);
+        t20 = centeredSub(n20); t21 = centeredSub(n21); t22 = centeredSub(n22);
+    }
+
+    int second = superspeed ? n->level - 3 : j;
+    Node* result = makeNode(
+        step(makeNode(t00, t01, t10, t11), second),
+        step(makeNode(t01, t02, t11, t12), second),
+        step(makeNode(t10, t11, t20, t21), second),
+        step(makeNode(t11, t12, t21, t22), second));
+
+    stepCache.emplace(key, result);
+    return result;
+}
+
+HashLife::Node* HashLife::build(int level, std::int64_t x0, std::int64_t y0,
+    const std::vector<unsigned char>& cells, int width, int height) {
+    const std::int64_t size = std::int64_t(1) << level;
+
+    // Squares entirely outside the board are canonical empty nodes; this is
+    // what keeps construction cheap for the padding around the board.
+    if (x0 >= width || y0 >= height || x0 + size <= 0 || y0 + size <= 0) {
+        return emptyNode(level);
+    }
+    if (level == 0) {
+        bool alive = x0 >= 0 && y0 >= 0 && x0 < width && y0 < height &&
+            cells[static_cast<size_t>(y0) * width + x0] != 0;
+        return makeLeaf(alive);
+    }
+    const std::int64_t half = size / 2;
+    return makeNode(
+        build(level - 1, x0, y0, cells, width, height),
+        build(level - 1, x0 + half, y0, cells, width, height),
+        build(level - 1, x0, y0 + half, cells, width, height),
+        build(level - 1, x0 + half, y0 + half, cells, width, height));
+}
+
+void HashLife::setBoard(const std::vector<unsigned char>& cells, int width, int height) {
+    if (width <= 0 || height <= 0 ||
+        cells.size() != static_cast<size_t>(width) * height) {
+        throw std::runtime_error("HashLife::setBoard: bad board dimensions");
+    }
+
+    // Start over: the node pool and caches belong to the previous universe.
+    pool.clear();
+    internTable.clear();
+    stepCache.clear();
+    emptyByLevel.clear();
+    pool.push_back({ nullptr, nullptr, nullptr, nullptr, 0, 0 });
+    deadLeaf = &pool.back();
+    pool.push_back({ nullptr, nullptr, nullptr, nullptr, 1, 0 });
+    aliveLeaf = &pool.back();
+
+    boardWidth = width;
+    boardHeight = height;
+
+    int level = 1;
+    while ((std::int64_t(1) << level) < std::max(width, height)) {
+        ++level;
+    }
+    level += 1; // One level of padding to start with; advance() adds more
+
+    // Center the board inside the root square.
+    const std::int64_t size = std::int64_t(1) << level;
+    originX = -(size - width) / 2;
+    originY = -(size - height) / 2;
+    root = build(level, originX, originY, cells, width, height);
+}
+
+void HashLife::advance(unsigned long long generations) {
+    if (!root) {
+        throw std::runtime_error("HashLife::advance: no board loaded");
+    }
+
+    for (int j = 0; j < 64; ++j) {
+        if (!(generations & (1ull << j))) continue;
+
+        // Grow the universe until the jump fits and every live cell sits in
+        // the central quarter, so nothing can escape the result square.
+        while (root->level < std::max(j + 2, 3) ||
+            root->population != centeredSub(centeredSub(root))->population) {
+            const std::int64_t size = std::int64_t(1) << root->level;
+            originX -= size / 2;
+            originY -= size / 2;
+            root = expand(root);
+        }
+
+        const std::int64_t size = std::int64_t(1) << root->level;
+        root = step(root, j);
+        originX += size / 4;
+        originY += size / 4;
+    }
+}
+
+void HashLife::collect(const Node* n, std::int64_t x0, std::int64_t y0,
+    std::vector<unsigned char>& out, int width, int height) const {
+    if (n->population == 0) return;
+    const std::int64_t size = std::int64_t(1) << n->level;
+    if (x0 >= width || y0 >= height || x0 + size <= 0 || y0 + size <= 0) return;
+
+    if (n->level == 0) {
+        out[static_cast<size_t>(y0) * width + x0] = 1;
+        return;
+    }
+    const std::int64_t half = size / 2;
+    collect(n->nw, x0, y0, out, width, height);
+    collect(n->ne, x0 + half, y0, out, width, height);
+    collect(n->sw, x0, y0 + half, out, width, height);
+    collect(n->se, x0 + half, y0 + half, out, width, height);
+}
+
+std::vector<unsigned char> HashLife::getBoard() const {
+    std::vector<unsigned char> out(static_cast<size_t>(boardWidth) * boardHeight, 0);
+    if (root) {
+        collect(root, originX, originY, out, boardWidth, boardHeight);
+    }
+    return out;
+}
+
+unsigned long long HashLife::population() const {
+    return root ? root->population : 0;
+}
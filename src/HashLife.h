@@ -0,0 +1,86 @@
+// src/HashLife.h
+// A HashLife engine for skipping large numbers of generations on the CPU.
+// The board is held as a quadtree of hash-consed nodes; advancing a node's
+// center is memoized, so regular patterns (still lifes, oscillators, guns)
+// advance in time roughly logarithmic in the generation count.
+//
+// Unlike the GPU stepper the universe here is an infinite dead plane, not a
+// torus, so results can differ near the board edges for patterns that touch
+// them.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+class HashLife {
+public:
+    HashLife();
+
+    // Builds the universe from a row-major board (0 = dead, nonzero = alive).
+    void setBoard(const std::vector<unsigned char>& cells, int width, int height);
+
+    // Advances the universe by exactly `generations` steps, decomposed into
+    // power-of-two superspeed jumps.
+    void advance(unsigned long long generations);
+
+    // Reads the original width x height window back out of the universe.
+    std::vector<unsigned char> getBoard() const;
+
+    unsigned long long population() const;
+
+private:
+    struct Node {
+        Node* nw;
+        Node* ne;
+        Node* sw;
+        Node* se;
+        unsigned long long population;
+        int level; // Node covers a 2^level x 2^level square
+    };
+
+    struct NodeKey {
+        Node* nw; Node* ne; Node* sw; Node* se;
+        bool operator==(const NodeKey& o) const {
+            return nw == o.nw && ne == o.ne && sw == o.sw && se == o.se;
+        }
+    };
+    struct NodeKeyHash {
+        std::size_t operator()(const NodeKey& k) const;
+    };
+    struct StepKey {
+        Node* node; int j;
+        bool operator==(const StepKey& o) const { return node == o.node && j == o.j; }
+    };
+    struct StepKeyHash {
+        std::size_t operator()(const StepKey& k) const;
+    };
+
+    Node* makeLeaf(bool alive);
+    Node* makeNode(Node* nw, Node* ne, Node* sw, Node* se);
+    Node* emptyNode(int level);
+    Node* centeredSub(Node* n);          // The level-1 node at n's center
+    Node* expand(Node* n);               // Wraps n in an empty border (level+1)
+    Node* step(Node* n, int j);          // Center of n advanced 2^j gens (j <= level-2)
+    Node* baseStep(Node* n);             // Level-2 node advanced one generation
+    Node* build(int level, std::int64_t x0, std::int64_t y0,
+        const std::vector<unsigned char>& cells, int width, int height);
+    void collect(const Node* n, std::int64_t x0, std::int64_t y0,
+        std::vector<unsigned char>& out, int width, int height) const;
+
+    std::deque<Node> pool;               // Stable storage for all nodes
+    std::unordered_map<NodeKey, Node*, NodeKeyHash> internTable;
+    std::unordered_map<StepKey, Node*, StepKeyHash> stepCache;
+    std::vector<Node*> emptyByLevel;
+    Node* aliveLeaf = nullptr;
+    Node* deadLeaf = nullptr;
+
+    Node* root = nullptr;
+    std::int64_t originX = 0;            // Board coords of the root square's corner
+    std::int64_t originY = 0;
+    int boardWidth = 0;
+    int boardHeight = 0;
+};
@@ -3,6 +3,7 @@
 
 #include "InputHandler.h"
 #include "Renderer.h"
+#include "ConsoleOverlay.h"
 #include <GLFW/glfw3.h>
 #include <iostream>
 
@@ -13,6 +14,7 @@ InputHandler::InputHandler(GLFWwindow* win, Renderer& rend)
 
 void InputHandler::setupCallbacks() {
     glfwSetKeyCallback(window, key_callback);
+    glfwSetCharCallback(window, char_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
     glfwSetScrollCallback(window, scroll_callback);
     glfwSetCursorPosCallback(window, cursor_position_callback);
@@ -45,6 +47,15 @@ void InputHandler::key_callback(GLFWwindow* window, int key, int scancode, int a
     InputHandler* handler = static_cast<InputHandler*>(glfwGetWindowUserPointer(window));
     if (!handler) return;
 
+    // While the console overlay is open it owns the keyboard: editing keys
+    // go to it (with key repeat for Backspace) and hotkeys are suppressed.
+    if (handler->console && handler->console->isOpen()) {
+        if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+            handler->console->onKey(key);
+        }
+        return;
+    }
+
     if (action == GLFW_PRESS) {
         handler->keys[key] = true;
         handler->keysProcessed[key] = false;
@@ -70,6 +81,15 @@ void InputHandler::key_callback(GLFWwindow* window, int key, int scancode, int a
     }
 }
 
+void InputHandler::char_callback(GLFWwindow* window, unsigned int codepoint) {
+    InputHandler* handler = static_cast<InputHandler*>(glfwGetWindowUserPointer(window));
+    if (!handler) return;
+
+    if (handler->console && handler->console->isOpen()) {
+        handler->console->onChar(codepoint);
+    }
+}
+
 void InputHandler::mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     InputHandler* handler = static_cast<InputHandler*>(glfwGetWindowUserPointer(window));
     if (!handler) return;
@@ -8,6 +8,7 @@
 // Forward declarations to avoid including full headers
 struct GLFWwindow;
 class Renderer;
+class ConsoleOverlay;
 
 class InputHandler {
 public:
@@ -15,6 +16,11 @@ public:
 
     void setupCallbacks();
 
+    // While the console overlay is open it receives all keyboard input
+    // (characters, Enter/Backspace/Escape) and the normal hotkeys are
+    // suppressed. May be null (benchmark mode).
+    void setConsoleOverlay(ConsoleOverlay* overlay) { console = overlay; }
+
     // State query methods
     bool wasKeyPressed(int key);
     bool getMouseDragState() const { return isLeftMouseDrag; }
@@ -28,6 +34,7 @@ public:
 
 private:
     static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void char_callback(GLFWwindow* window, unsigned int codepoint);
     static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
     static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
     static void cursor_position_callback(GLFWwindow* window, double xpos, double ypos);
@@ -35,6 +42,7 @@ private:
 
     GLFWwindow* window;
     Renderer& renderer;
+    ConsoleOverlay* console = nullptr;
 
     bool keys[1024] = { false };
     bool keysProcessed[1024] = { false };
@@ -0,0 +1,79 @@
+// src/MutationLog.cpp
+// Implementation of mutation recording and replay loading.
+
+#include "MutationLog.h"
+#include <sstream>
+#include <stdexcept>
+
+MutationLog::MutationLog(const std::string& path) : out(path) {
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not open mutation log for writing: " + path);
+    }
+    out << "# GameOfLife mutation log v1\n";
+}
+
+void MutationLog::recordRandomize(unsigned long long generation, unsigned int seed) {
+    out << "randomize " << generation << ' ' << seed << '\n';
+    out.flush(); // Mutations are rare; keep the log valid even on a crash
+}
+
+void MutationLog::recordClear(unsigned long long generation) {
+    out << "clear " << generation << '\n';
+    out.flush();
+}
+
+void MutationLog::recordCell(unsigned long long generation, int x, int y, bool alive) {
+    // Brush strokes produce bursts of these; flushed once per line is still
+    // cheap next to the GL work that triggered them.
+    out << "cell " << generation << ' ' << x << ' ' << y << ' ' << (alive ? 1 : 0) << '\n';
+}
+
+void MutationLog::recordSkip(unsigned long long generation, unsigned long long count) {
+    out << "skip " << generation << ' ' << count << '\n';
+    out.flush();
+}
+
+std::vector<Mutation> MutationLog::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open mutation log: " + path);
+    }
+
+    std::vector<Mutation> mutations;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string keyword;
+        fields >> keyword;
+
+        Mutation m;
+        if (keyword == "randomize") {
+            m.type = Mutation::Type::Randomize;
+            fields >> m.generation >> m.seed;
+        }
+        else if (keyword == "clear") {
+            m.type = Mutation::Type::Clear;
+            fields >> m.generation;
+        }
+        else if (keyword == "cell") {
+            int alive = 0;
+            m.type = Mutation::Type::Cell;
+            fields >> m.generation >> m.x >> m.y >> alive;
+            m.alive = alive != 0;
+        }
+        else if (keyword == "skip") {
+            m.type = Mutation::Type::Skip;
+            fields >> m.generation >> m.count;
+        }
+        else {
+            throw std::runtime_error("Unknown mutation log entry: " + line);
+        }
+        if (fields.fail()) {
+            throw std::runtime_error("Malformed mutation log entry: " + line);
+        }
+        mutations.push_back(m);
+    }
+    return mutations;
+}
@@ -0,0 +1,45 @@
+// src/MutationLog.h
+// Records board mutations (randomize, clear, individual cell writes,
+// HashLife skips) to a compact text log keyed by the generation they were
+// applied at, and loads such logs back for replay. Together with --seed
+// this makes a session reproducible: replaying the log against the same
+// build and grid yields the same board history, so performance regressions
+// can be bisected with identical workloads. Checkpoint loads and grid
+// resizes are not recorded; a replay must start from the same grid size.
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct Mutation {
+    enum class Type { Randomize, Clear, Cell, Skip };
+
+    Type type;
+    unsigned long long generation = 0; // Board generation at apply time
+    unsigned int seed = 0;             // Randomize only
+    int x = 0;                         // Cell only
+    int y = 0;
+    bool alive = false;
+    unsigned long long count = 0;      // Skip only
+};
+
+class MutationLog {
+public:
+    // Opens the log file for recording. Throws std::runtime_error when the
+    // file cannot be created.
+    explicit MutationLog(const std::string& path);
+
+    void recordRandomize(unsigned long long generation, unsigned int seed);
+    void recordClear(unsigned long long generation);
+    void recordCell(unsigned long long generation, int x, int y, bool alive);
+    void recordSkip(unsigned long long generation, unsigned long long count);
+
+    // Parses a recorded log into apply order. Throws std::runtime_error on
+    // files that cannot be opened or contain unknown entries.
+    static std::vector<Mutation> load(const std::string& path);
+
+private:
+    std::ofstream out;
+};
@@ -0,0 +1,90 @@
+// src/PatternLoader.cpp
+// Implementation of the RLE pattern file parser.
+
+#include "PatternLoader.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cctype>
+
+Pattern PatternLoader::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open pattern file: " + path);
+    }
+
+    Pattern pattern;
+    pattern.name = path;
+
+    std::string line;
+    bool headerSeen = false;
+    int x = 0, y = 0;        // Cursor inside the pattern bounding box
+    int runCount = 0;        // Pending run length (0 means "1 when applied")
+    bool done = false;
+
+    while (!done && std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        // Comment lines: keep the "#N <name>" line if there is one.
+        if (line[0] == '#') {
+            if (line.size() > 2 && line[1] == 'N') {
+                pattern.name = line.substr(2);
+                while (!pattern.name.empty() && pattern.name.front() == ' ') {
+                    pattern.name.erase(pattern.name.begin());
+                }
+            }
+            continue;
+        }
+
+        // Header line: "x = W, y = H, rule = ...". The rule is ignored here;
+        // the board always runs the rule the simulation was built with.
+        if (!headerSeen) {
+            std::stringstream ss(line);
+            char c;
+            if (!(ss >> c >> c >> pattern.width >> c >> c >> c >> pattern.height) ||
+                pattern.width <= 0 || pattern.height <= 0) {
+                throw std::runtime_error("Malformed RLE header in " + path);
+            }
+            headerSeen = true;
+            continue;
+        }
+
+        // Body: runs of 'b' (dead), 'o' (alive), '$' (end of row), '!' (end).
+        for (char c : line) {
+            if (std::isdigit(static_cast<unsigned char>(c))) {
+                runCount = runCount * 10 + (c - '0');
+            }
+            else if (c == 'b' || c == 'o') {
+                int run = (runCount == 0) ? 1 : runCount;
+                if (c == 'o') {
+                    for (int i = 0; i < run; ++i) {
+                        pattern.cells.emplace_back(x + i, y);
+                    }
+                }
+                x += run;
+                runCount = 0;
+            }
+            else if (c == '$') {
+                int run = (runCount == 0) ? 1 : runCount;
+                y += run;
+                x = 0;
+                runCount = 0;
+            }
+            else if (c == '!') {
+                done = true;
+                break;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r') {
+                continue;
+            }
+            else {
+                throw std::runtime_error(std::string("Unexpected character '") + c + "' in " + path);
+            }
+        }
+    }
+
+    if (!headerSeen) {
+        throw std::runtime_error("No RLE header found in " + path);
+    }
+    return pattern;
+}
@@ -0,0 +1,24 @@
+// src/PatternLoader.h
+// Loads Life patterns from standard .rle files (the format used by Golly and
+// the LifeWiki pattern collection) into a decoded cell list for stamping.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// A decoded pattern: bounding box plus the live cells inside it.
+// Cell coordinates are (x, y) with y = 0 at the top row, as in the RLE file.
+struct Pattern {
+    int width = 0;
+    int height = 0;
+    std::vector<std::pair<int, int>> cells;
+    std::string name; // From the "#N" comment when present, else the filename
+};
+
+class PatternLoader {
+public:
+    // Parses an .rle file. Throws std::runtime_error on I/O or syntax errors.
+    static Pattern load(const std::string& path);
+};
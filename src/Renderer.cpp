@@ -2,38 +2,234 @@
 // Implementation of the Renderer class.
 
 #include "Renderer.h"
+#include "PatternLoader.h"
+#include "HashLife.h"
+#include "SnapshotWriter.h"
+#include "MutationLog.h"
+#include "FrameExporter.h"
+#include "Checkpoint.h"
+#include "RuleParser.h"
 #include <GL/glew.h>
+#include <chrono>
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <random>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 
-Renderer::Renderer(GLFWwindow* win, int winWidth, int winHeight, int gridW, int gridH)
+namespace {
+    // CPU mirror of the std140 ViewParams block in draw.vert. vec2 members
+    // are 8-byte aligned, so the layout matches with no manual padding.
+    struct ViewParams {
+        float pan[2];
+        float resolution[2];
+        float gridResolution[2];
+        float zoom;
+        float lod; // Mip level for zoomed-out density rendering (0 = off)
+    };
+
+}
+
+Renderer::Renderer(GLFWwindow* win, int winWidth, int winHeight, int gridW, int gridH, bool packed, bool useCompute, const std::string& rule)
     : window(win),
     windowWidth(winWidth),
     windowHeight(winHeight),
     GRID_WIDTH(gridW),
-    GRID_HEIGHT(gridH) {
+    GRID_HEIGHT(gridH),
+    packedBoard(packed) {
+
+    // Compile the rule into the step kernels as bitmask #defines: the
+    // per-cell branch chain becomes one bit test and each rule is its own
+    // cached program variant, so there is no per-cell lookup cost.
+    unsigned int birthMask = 0, survivalMask = 0;
+    parseLifeRule(rule, birthMask, survivalMask);
+    ruleName = rule;
+    classicRule = (birthMask == 0x08u && survivalMask == 0x0Cu);
+    rulePreamble = makeRulePreamble(birthMask, survivalMask);
+    if (!classicRule) {
+        std::cout << "Using rule " << ruleName << "." << std::endl;
+    }
+
+    if (packedBoard && GRID_WIDTH % 32 != 0) {
+        // The packed kernel wraps horizontally at word granularity, which is
+        // only exact when the row is a whole number of 32-bit words.
+        GRID_WIDTH = ((GRID_WIDTH + 31) / 32) * 32;
+        std::cout << "Packed board: grid width rounded up to " << GRID_WIDTH << " (multiple of 32)." << std::endl;
+    }
+
+    if (packedBoard) {
+        computeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute_packed.frag", rulePreamble);
+        drawProgram = std::make_unique<Shader>("shaders/draw.vert", "shaders/draw_packed.frag");
+        randomizeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/randomize_packed.frag");
+    }
+    else {
+        computeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute.frag", rulePreamble);
+        drawProgram = std::make_unique<Shader>("shaders/draw.vert", "shaders/draw.frag");
+        randomizeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/randomize.frag");
+        doubleStepProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute_double.frag", rulePreamble);
+        // High-zoom path: instanced inset quads with a vertex-stage board
+        // fetch (see drawToScreen). Float board only; the packed draw
+        // shader keeps doing its own word decode per pixel.
+        cellsProgram = std::make_unique<Shader>("shaders/cells.vert", "shaders/cells.frag");
+    }
 
-    computeProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute.frag");
-    drawProgram = std::make_unique<Shader>("shaders/draw.vert", "shaders/draw.frag");
+    // The compute engine needs image load/store and compute dispatch (GL 4.3).
+    // The shared-memory tiling kernel is written for the float board; packed
+    // boards keep the fragment path, which is already word-parallel.
+    if (useCompute) {
+        if (packedBoard) {
+            std::cout << "Compute engine not available for the packed board; using fragment path." << std::endl;
+        }
+        else if (!GLEW_ARB_compute_shader) {
+            std::cout << "Compute shaders not supported by this driver; using fragment path." << std::endl;
+        }
+        else {
+            computeEngineProgram = std::make_unique<Shader>("shaders/life.comp", rulePreamble);
+            computeEngine = true;
+            std::cout << "Using GL 4.3 compute-shader simulation engine." << std::endl;
+        }
+    }
 
     initQuad();
     initTextures();
     initFramebuffers();
     resetView();
 
+    // Activity tracking compares the float ping-pong pair; the packed board
+    // keeps its always-full update (its kernel is already word-parallel) and
+    // tiled boards have no single texture pair to compare.
+    if (!packedBoard && !tiledBoard()) {
+        activityProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/activity.frag");
+        initActivityResources();
+    }
+
+    // Statistics readback buffers: each holds the single float average from
+    // the top of the board's mip chain.
+    if (!packedBoard) {
+        glGenBuffers(2, statsPbo);
+        for (int i = 0; i < 2; ++i) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, statsPbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(float), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    // View parameter UBO, written once per frame in drawToScreen.
+    drawProgram->bindUniformBlock("ViewParams", 0);
+    if (cellsProgram) cellsProgram->bindUniformBlock("ViewParams", 0);
+    glGenBuffers(1, &viewUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, viewUbo);
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    viewUboStride = ((static_cast<GLint>(sizeof(ViewParams)) + alignment - 1) / alignment) * alignment;
+    if (GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, viewUboStride * VIEW_UBO_SLOTS, nullptr, flags);
+        viewUboPtr = static_cast<unsigned char*>(
+            glMapBufferRange(GL_UNIFORM_BUFFER, 0, viewUboStride * VIEW_UBO_SLOTS, flags));
+    }
+    if (!viewUboPtr) {
+        glBufferData(GL_UNIFORM_BUFFER, viewUboStride, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, 0, viewUbo);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Snapshot writer thread; PBOs are created lazily on first request.
+    snapshotWriter = std::make_unique<SnapshotWriter>();
+
     // Calculate the initial max zoom level
     float maxDimension = std::max(GRID_WIDTH, GRID_HEIGHT);
     maxZoom = maxDimension / 10.0f; // Allow zooming to see a minimum of 10 cells
 }
 
 Renderer::~Renderer() {
+    stopThreadedSimulation();
+    stopFrameExport();
     glDeleteVertexArrays(1, &quadVAO);
     glDeleteBuffers(1, &quadVBO);
     glDeleteFramebuffers(2, fbo);
     glDeleteTextures(2, textures);
+    for (int i = 0; i < 2; ++i) {
+        if (statsFence[i]) glDeleteSync(statsFence[i]);
+    }
+    if (statsPbo[0]) glDeleteBuffers(2, statsPbo);
+    if (activityFbo) glDeleteFramebuffers(1, &activityFbo);
+    if (activityTex) glDeleteTextures(1, &activityTex);
+    for (int i = 0; i < SNAPSHOT_RING_SIZE; ++i) {
+        if (snapshotFence[i]) glDeleteSync(snapshotFence[i]);
+        if (snapshotPbo[i]) glDeleteBuffers(1, &snapshotPbo[i]);
+    }
+    for (int i = 0; i < 2; ++i) {
+        if (signatureFence[i]) glDeleteSync(signatureFence[i]);
+    }
+    if (signaturePbo[0]) glDeleteBuffers(2, signaturePbo);
+    if (signatureFbo) glDeleteFramebuffers(1, &signatureFbo);
+    if (signatureTex) glDeleteTextures(1, &signatureTex);
+    if (viewUboPtr) {
+        glBindBuffer(GL_UNIFORM_BUFFER, viewUbo);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &viewUbo);
+    destroyStagingPool();
+    // snapshotWriter's destructor drains any queued writes before returning.
+}
+
+// (Re)creates the one-texel-per-tile activity map texture and FBO.
+void Renderer::initActivityResources() {
+    if (activityFbo) glDeleteFramebuffers(1, &activityFbo);
+    if (activityTex) glDeleteTextures(1, &activityTex);
+
+    glGenTextures(1, &activityTex);
+    glBindTexture(GL_TEXTURE_2D, activityTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, tilesX(), tilesY(), 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &activityFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, activityFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, activityTex, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    tileWorkList.assign(tilesX() * tilesY(), 1);
+    activityMapValid = false;
+}
+
+void Renderer::toggleActivityTracking() {
+    if (simThreadRunning.load()) {
+        std::cout << "Activity tracking is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (packedBoard) {
+        std::cout << "Activity tracking is not available for the packed board." << std::endl;
+        return;
+    }
+    if (computeEngine) {
+        std::cout << "Activity tracking applies to the fragment path; ignored with --compute." << std::endl;
+        return;
+    }
+    if (tiledBoard()) {
+        std::cout << "Activity tracking is not available for tiled boards." << std::endl;
+        return;
+    }
+    if (!activityProgram) {
+        // The board started out tiled, so the resources were never built.
+        activityProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/activity.frag");
+        initActivityResources();
+    }
+    activityTracking = !activityTracking;
+    activityMapValid = false; // Force one full update before skipping anything
+    if (activityTracking && fusedKernel) {
+        // See toggleFusedKernel: a two-generation stride breaks the
+        // consecutive-generation change detection, so the two are exclusive.
+        fusedKernel = false;
+        std::cout << "Fused double-step kernel disabled (incompatible with activity tracking)." << std::endl;
+    }
+    std::cout << "Activity tracking " << (activityTracking ? "ON" : "OFF") << std::endl;
 }
 
 void Renderer::onWindowResize(int newWidth, int newHeight) {
@@ -81,10 +277,67 @@ void Renderer::initQuad() {
 }
 
 void Renderer::initTextures() {
+    // Boards that exceed the driver's maximum texture dimension are split
+    // across a GL_TEXTURE_2D_ARRAY of square tiles, one layer per tile. The
+    // tiled shader variants resolve global cell coordinates to layers, so
+    // no per-generation halo exchange is needed between neighbors.
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    tileSize = 0;
+    tileCols = 1;
+    tileRows = 1;
+
+    if (!packedBoard && (GRID_WIDTH > maxTextureSize || GRID_HEIGHT > maxTextureSize)) {
+        tileSize = maxTextureSize;
+        tileCols = (GRID_WIDTH + tileSize - 1) / tileSize;
+        tileRows = (GRID_HEIGHT + tileSize - 1) / tileSize;
+        std::cout << "Grid " << GRID_WIDTH << "x" << GRID_HEIGHT
+            << " exceeds GL_MAX_TEXTURE_SIZE (" << maxTextureSize << "); tiling as "
+            << tileCols << "x" << tileRows << " tiles of "
+            << tileSize << "x" << tileSize << "." << std::endl;
+
+        if (computeEngine) {
+            computeEngine = false;
+            std::cout << "Compute engine targets the single-texture board; using the tiled fragment path." << std::endl;
+        }
+        if (!computeTiledProgram) {
+            computeTiledProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/compute_tiled.frag", rulePreamble);
+            drawTiledProgram = std::make_unique<Shader>("shaders/draw.vert", "shaders/draw_tiled.frag");
+            randomizeTiledProgram = std::make_unique<Shader>("shaders/compute.vert", "shaders/randomize_tiled.frag");
+            drawTiledProgram->bindUniformBlock("ViewParams", 0);
+        }
+
+        glGenTextures(2, textures);
+        for (int i = 0; i < 2; ++i) {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, textures[i]);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32F, tileSize, tileSize,
+                tileCols * tileRows, 0, GL_RED, GL_FLOAT, nullptr);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return;
+    }
+
+    if (packedBoard && GRID_HEIGHT > maxTextureSize) {
+        // The packed kernel's word-level wrap does not translate to tiles;
+        // cap the board instead of producing a broken one.
+        GRID_HEIGHT = maxTextureSize;
+        std::cout << "Packed board height capped at GL_MAX_TEXTURE_SIZE (" << maxTextureSize << ")." << std::endl;
+    }
+
     glGenTextures(2, textures);
     for (int i = 0; i < 2; ++i) {
         glBindTexture(GL_TEXTURE_2D, textures[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, GRID_WIDTH, GRID_HEIGHT, 0, GL_RED, GL_FLOAT, nullptr);
+        if (packedBoard) {
+            // One R32UI texel stores 32 cells, so the texture is 32x narrower.
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, textureWidth(), GRID_HEIGHT, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        }
+        else {
+            // Sized GL_R32F (rather than unsized GL_RED) so the texture is
+            // also usable for image load/store by the compute engine.
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, GRID_WIDTH, GRID_HEIGHT, 0, GL_RED, GL_FLOAT, nullptr);
+        }
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -95,6 +348,11 @@ void Renderer::initTextures() {
 
 void Renderer::initFramebuffers() {
     glGenFramebuffers(2, fbo);
+    if (tiledBoard()) {
+        // Tiled boards attach one array layer at a time (attachTileLayer)
+        // right before each per-tile pass, so nothing is attached here.
+        return;
+    }
     for (int i = 0; i < 2; ++i) {
         glBindFramebuffer(GL_FRAMEBUFFER, fbo[i]);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[i], 0);
@@ -105,6 +363,12 @@ void Renderer::initFramebuffers() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+// Points a framebuffer's color attachment at one layer of a tile array.
+void Renderer::attachTileLayer(GLuint framebuffer, GLuint texture, int layer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture, 0, layer);
+}
+
 // Helper for linear interpolation (the C++ version of GLSL's mix function)
 float mix(float a, float b, float t) {
     return a * (1.0f - t) + b * t;
@@ -131,6 +395,32 @@ std::pair<float, float> Renderer::screenToTextureCoords(double screenX, double s
     if (abs(normX) > abs(scaleX) || abs(normY) > abs(scaleY)) {
         return { -1.0f, -1.0f };
     }
+    return screenToTextureCoordsClamped(screenX, screenY);
+}
+
+// Like screenToTextureCoords, but points in the letterbox clamp to the
+// nearest edge of the scaled quad instead of returning the {-1,-1} pick
+// sentinel. The window corners sit in the letterbox whenever the window and
+// grid aspects differ, so rectangle queries built from them (visible-region
+// stepping) must not use the sentinel.
+std::pair<float, float> Renderer::screenToTextureCoordsClamped(double screenX, double screenY) const {
+    // Normalize the coordinates to [-1, 1] range, with Y inverted.
+    float normX = (float)(screenX / windowWidth) * 2.0f - 1.0f;
+    float normY = 1.0f - (float)(screenY / windowHeight) * 2.0f;
+
+    // Re-calculate the aspect ratio scaling exactly as in the vertex shader.
+    float windowAspect = (float)windowWidth / (float)windowHeight;
+    float gridAspect = (float)GRID_WIDTH / (float)GRID_HEIGHT;
+    float scaleX = 1.0f, scaleY = 1.0f;
+    if (windowAspect > gridAspect) {
+        scaleX = gridAspect / windowAspect;
+    }
+    else {
+        scaleY = windowAspect / gridAspect;
+    }
+
+    normX = std::clamp(normX, -scaleX, scaleX);
+    normY = std::clamp(normY, -scaleY, scaleY);
     float unscaledX = normX / scaleX;
     float unscaledY = normY / scaleY;
 
@@ -147,30 +437,184 @@ std::pair<float, float> Renderer::screenToTextureCoords(double screenX, double s
 }
 
 void Renderer::randomizeBoard() {
-    std::vector<float> data(GRID_WIDTH * GRID_HEIGHT);
-    std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<> distrib(0, 1);
-    for (auto& cell : data) {
-        cell = static_cast<float>(distrib(gen));
+    randomizeBoard(std::random_device{}());
+}
+
+// Fills the board with a hash-based PRNG pass rendered straight into the
+// current FBO. No CPU-side buffer, no PCIe upload: instant at any grid size,
+// and the same seed always produces the same board.
+void Renderer::randomizeBoard(unsigned int seed) {
+    if (mutationLog) mutationLog->recordRandomize(generationCount, seed);
+    resetStabilization(); // A fresh board restarts cycle detection
+    if (simThreadRunning.load()) {
+        // Runs on the worker's context between steps.
+        boardSeed = seed;
+        simCommandSeed.store(seed);
+        simCommand.store(2);
+        std::cout << "Board randomize (seed " << seed << ") queued to the simulation thread." << std::endl;
+        return;
     }
-    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_FLOAT, data.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
-    std::cout << "Board randomized." << std::endl;
+
+    if (tiledBoard()) {
+        randomizeTiledProgram->use();
+        randomizeTiledProgram->setUInt("u_seed", seed);
+        randomizeTiledProgram->setInt("u_gridWidth", GRID_WIDTH);
+        randomizeTiledProgram->setInt("u_gridHeight", GRID_HEIGHT);
+        glViewport(0, 0, tileSize, tileSize);
+        glBindVertexArray(quadVAO);
+        for (int t = 0; t < tileCols * tileRows; ++t) {
+            attachTileLayer(fbo[currentTextureIndex], textures[currentTextureIndex], t);
+            randomizeTiledProgram->setInt("u_tileOriginX", (t % tileCols) * tileSize);
+            randomizeTiledProgram->setInt("u_tileOriginY", (t / tileCols) * tileSize);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        activityMapValid = false;
+        ++boardRevision;
+        boardSeed = seed;
+        generationCount = 0;
+        std::cout << "Board randomized (seed " << seed << ")." << std::endl;
+        return;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glViewport(0, 0, textureWidth(), GRID_HEIGHT);
+    randomizeProgram->use();
+    randomizeProgram->setUInt("u_seed", seed);
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    activityMapValid = false;
+    ++boardRevision;
+    boardSeed = seed;
+    generationCount = 0;
+    std::cout << "Board randomized (seed " << seed << ")." << std::endl;
 }
 
 void Renderer::clearBoard() {
+    if (mutationLog) mutationLog->recordClear(generationCount);
+    resetStabilization(); // A fresh board restarts cycle detection
+    if (simThreadRunning.load()) {
+        // Runs on the worker's context between steps.
+        boardSeed = 0;
+        simCommand.store(1);
+        std::cout << "Board clear queued to the simulation thread." << std::endl;
+        return;
+    }
+
+    if (tiledBoard()) {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        for (int i = 0; i < 2; ++i) {
+            for (int t = 0; t < tileCols * tileRows; ++t) {
+                attachTileLayer(fbo[i], textures[i], t);
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        activityMapValid = false;
+        ++boardRevision;
+        boardSeed = 0;
+        generationCount = 0;
+        std::cout << "Board cleared." << std::endl;
+        return;
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, fbo[currentTextureIndex]);
-    glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    glViewport(0, 0, textureWidth(), GRID_HEIGHT);
+    if (packedBoard) {
+        // glClear is undefined for integer color buffers; clear explicitly.
+        GLuint zero[4] = { 0, 0, 0, 0 };
+        glClearBufferuiv(GL_COLOR, 0, zero);
+    }
+    else {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    activityMapValid = false;
+    ++boardRevision;
+    boardSeed = 0;
+    generationCount = 0;
     std::cout << "Board cleared." << std::endl;
 }
 
 void Renderer::runSimulationStep() {
+    // Capture the completed generation before stepping away from it.
+    if (frameExporter) serviceFrameExport();
+    if (autoStopEnabled) checkStabilization();
+
+    ++generationCount;
+    ++boardRevision;
+
+    if (tiledBoard()) {
+        // One pass per destination layer; the source array is sampled freely
+        // across layers, so seams and wrap come out of the coordinate math.
+        computeTiledProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures[currentTextureIndex]);
+        computeTiledProgram->setInt("u_currentState", 0);
+        computeTiledProgram->setInt("u_gridWidth", GRID_WIDTH);
+        computeTiledProgram->setInt("u_gridHeight", GRID_HEIGHT);
+        computeTiledProgram->setInt("u_tileSize", tileSize);
+        computeTiledProgram->setInt("u_tileCols", tileCols);
+        glViewport(0, 0, tileSize, tileSize);
+        glBindVertexArray(quadVAO);
+        for (int t = 0; t < tileCols * tileRows; ++t) {
+            attachTileLayer(fbo[1 - currentTextureIndex], textures[1 - currentTextureIndex], t);
+            computeTiledProgram->setInt("u_tileOriginX", (t % tileCols) * tileSize);
+            computeTiledProgram->setInt("u_tileOriginY", (t / tileCols) * tileSize);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        currentTextureIndex = 1 - currentTextureIndex;
+        return;
+    }
+
+    if (computeEngine) {
+        // Compute path: no FBO/VAO/raster setup, just two image bindings and
+        // a dispatch. Workgroups are 16x16, matching the kernel's tile size.
+        computeEngineProgram->use();
+        glBindImageTexture(0, textures[currentTextureIndex], 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(1, textures[1 - currentTextureIndex], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((GRID_WIDTH + 15) / 16, (GRID_HEIGHT + 15) / 16, 1);
+        // Make the image writes visible to the next step's loads and to the
+        // draw pass's texture fetches.
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        currentTextureIndex = 1 - currentTextureIndex;
+        return;
+    }
+
+    if (activityTracking && activityMapValid) {
+        // Carry the whole board forward (pure bandwidth), then recompute only
+        // the tiles on the work list under a scissor rect each.
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+        glBlitFramebuffer(0, 0, GRID_WIDTH, GRID_HEIGHT, 0, 0, GRID_WIDTH, GRID_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+        glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+        computeProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+        computeProgram->setInt("u_currentState", 0);
+        glBindVertexArray(quadVAO);
+
+        glEnable(GL_SCISSOR_TEST);
+        for (int ty = 0; ty < tilesY(); ++ty) {
+            for (int tx = 0; tx < tilesX(); ++tx) {
+                if (!tileWorkList[ty * tilesX() + tx]) continue;
+                glScissor(tx * 32, ty * 32, 32, 32);
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
+        }
+        glDisable(GL_SCISSOR_TEST);
+        currentTextureIndex = 1 - currentTextureIndex;
+        updateActivityMap();
+        return;
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
-    glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+    glViewport(0, 0, textureWidth(), GRID_HEIGHT);
     computeProgram->use();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
@@ -178,94 +622,1681 @@ void Renderer::runSimulationStep() {
     glBindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     currentTextureIndex = 1 - currentTextureIndex;
+
+    if (activityTracking) {
+        updateActivityMap();
+    }
 }
 
-void Renderer::drawToScreen() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, windowWidth, windowHeight);
-    glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-    drawProgram->use();
+void Renderer::stepVisibleRegion() {
+    if (simThreadRunning.load()) {
+        std::cout << "Visible-region stepping is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (tiledBoard()) {
+        std::cout << "Visible-region stepping is not available for tiled boards." << std::endl;
+        return;
+    }
+    if (packedBoard) {
+        std::cout << "Visible-region stepping is not available for the packed board." << std::endl;
+        return;
+    }
+
+    // The screen corners map to texture coordinates with the same math as
+    // mouse picks, but through the clamped variant: the corners sit in the
+    // letterbox whenever the window and grid aspects differ, where the pick
+    // sentinel would poison the rectangle. Min/max of the two corners keeps
+    // this independent of screen-space orientation.
+    auto cornerA = screenToTextureCoordsClamped(0.0, 0.0);
+    auto cornerB = screenToTextureCoordsClamped(windowWidth, windowHeight);
+    float u0 = std::min(cornerA.first, cornerB.first);
+    float u1 = std::max(cornerA.first, cornerB.first);
+    float v0 = std::min(cornerA.second, cornerB.second);
+    float v1 = std::max(cornerA.second, cornerB.second);
+
+    // The halo keeps activity just outside the view flowing in correctly
+    // for a handful of consecutive steps, not just the first.
+    const int halo = 32;
+    int rx = std::max(static_cast<int>(std::floor(u0 * GRID_WIDTH)) - halo, 0);
+    int ry = std::max(static_cast<int>(std::floor(v0 * GRID_HEIGHT)) - halo, 0);
+    int rx1 = std::min(static_cast<int>(std::ceil(u1 * GRID_WIDTH)) + halo, GRID_WIDTH);
+    int ry1 = std::min(static_cast<int>(std::ceil(v1 * GRID_HEIGHT)) + halo, GRID_HEIGHT);
+    if (rx1 <= rx || ry1 <= ry) {
+        std::cout << "The view is entirely off the board; nothing to step." << std::endl;
+        return;
+    }
+
+    ++generationCount;
+    ++boardRevision;
+
+    // Same carry-then-recompute shape as activity tracking: the whole board
+    // blits forward (pure bandwidth), then one scissored pass recomputes the
+    // visible rectangle. Every recomputed cell reads the full old board, so
+    // the rectangle's interior advances exactly. The fragment kernel is used
+    // even under --compute: a dispatch has no scissor.
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+    glBlitFramebuffer(0, 0, GRID_WIDTH, GRID_HEIGHT, 0, 0, GRID_WIDTH, GRID_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+    glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+    computeProgram->use();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
-    drawProgram->setInt("u_screenTexture", 0);
-    drawProgram->setVec2("u_pan", panX, panY);
-    drawProgram->setFloat("u_zoom", zoom);
-    drawProgram->setVec2("u_resolution", (float)windowWidth, (float)windowHeight);
-    drawProgram->setVec2("u_gridResolution", (float)GRID_WIDTH, (float)GRID_HEIGHT);
+    computeProgram->setInt("u_currentState", 0);
     glBindVertexArray(quadVAO);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(rx, ry, rx1 - rx, ry1 - ry);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    currentTextureIndex = 1 - currentTextureIndex;
+
+    activityMapValid = false; // The mixed-generation board invalidates tracking
 }
 
-void Renderer::handleMouseDrawing(bool isLeftMouseDrag, const std::pair<double, double>& mousePos, bool isGliderMode, int gliderRotation) {
-    if (!isLeftMouseDrag) return;
+void Renderer::toggleFusedKernel() {
+    if (simThreadRunning.load()) {
+        std::cout << "The fused double-step kernel is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (packedBoard) {
+        std::cout << "The fused double-step kernel is not available for the packed board." << std::endl;
+        return;
+    }
+    if (computeEngine) {
+        std::cout << "The fused double-step kernel applies to the fragment path; ignored with --compute." << std::endl;
+        return;
+    }
+    if (tiledBoard()) {
+        std::cout << "The fused double-step kernel is not available for tiled boards." << std::endl;
+        return;
+    }
+    fusedKernel = !fusedKernel;
+    if (fusedKernel && activityTracking) {
+        // The activity map compares consecutive generations; with a stride of
+        // two, period-2 oscillators would read as static and get skipped.
+        activityTracking = false;
+        std::cout << "Activity tracking disabled (incompatible with the fused kernel)." << std::endl;
+    }
+    std::cout << "Fused double-step kernel " << (fusedKernel ? "ON" : "OFF") << std::endl;
+}
 
-    // THIS FUNCTION IS NOW SIMPLER
-    // We get the final texture coordinate directly from our corrected conversion function.
-    auto texCoords = screenToTextureCoords(mousePos.first, mousePos.second);
+bool Renderer::canDoubleStep() const {
+    return fusedKernel && !packedBoard && !computeEngine && !activityTracking && !tiledBoard();
+}
 
-    if (texCoords.first < 0.f || texCoords.first > 1.f || texCoords.second < 0.f || texCoords.second > 1.f) {
-        return; // Click was outside the valid grid area
+// Advances two generations in one full-screen pass (25 taps, one FBO swap)
+// instead of two passes of 9 taps each. Only called when the accumulator
+// owes at least two steps, so the visible cadence is unchanged.
+void Renderer::runSimulationDoubleStep() {
+    if (frameExporter) serviceFrameExport();
+    if (autoStopEnabled) checkStabilization();
+
+    generationCount += 2;
+    ++boardRevision;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[1 - currentTextureIndex]);
+    glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+    doubleStepProgram->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+    doubleStepProgram->setInt("u_currentState", 0);
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    currentTextureIndex = 1 - currentTextureIndex;
+}
+
+void Renderer::startThreadedSimulation() {
+    if (simThreadRunning.load()) return;
+    if (packedBoard || computeEngine || tiledBoard()) {
+        std::cout << "Threaded run-ahead supports the plain fragment path only; ignored." << std::endl;
+        return;
+    }
+    if (activityTracking || fusedKernel) {
+        activityTracking = false;
+        fusedKernel = false;
+        std::cout << "Activity tracking and the fused kernel are disabled with threaded run-ahead." << std::endl;
+    }
+    if (frameExporter) {
+        std::cout << "Threaded run-ahead is not available while exporting frames; ignored." << std::endl;
+        return;
+    }
+    if (autoStopEnabled) {
+        std::cout << "Threaded run-ahead is not available with auto-stop; ignored." << std::endl;
+        return;
     }
 
-    int gridX = static_cast<int>(texCoords.first * GRID_WIDTH);
-    int gridY = static_cast<int>(texCoords.second * GRID_HEIGHT);
+    // A hidden 1x1 window sharing the main context gives the worker its own
+    // command stream while textures, programs and fences stay common. The
+    // context version hints from initWindow are still in effect.
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    simWindow = glfwCreateWindow(1, 1, "simulation", nullptr, window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!simWindow) {
+        std::cout << "Could not create a shared-context window; threaded run-ahead disabled." << std::endl;
+        return;
+    }
 
-    if (isGliderMode) {
-        static const std::vector<std::pair<int, int>> gliderPattern = { {1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2} };
-        drawPattern(gridX, gridY, gliderPattern, gliderRotation);
+    // Third board texture so the worker always has a destination that is
+    // neither its source nor the texture currently on screen.
+    glGenTextures(1, &runAheadTexture);
+    glBindTexture(GL_TEXTURE_2D, runAheadTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, GRID_WIDTH, GRID_HEIGHT, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    boardTriple[0] = textures[0];
+    boardTriple[1] = textures[1];
+    boardTriple[2] = runAheadTexture;
+    displayedBoard.store(currentTextureIndex);
+    publishedBoard = currentTextureIndex;
+    publishedGeneration = generationCount;
+
+    // Make sure the worker's first step sees every board write issued so far.
+    glFinish();
+
+    simThreadStop.store(false);
+    simThreadRunning.store(true);
+    simThread = std::thread(&Renderer::simThreadMain, this);
+    std::cout << "Threaded run-ahead ON: the simulation now steps continuously on a worker thread." << std::endl;
+}
+
+// The worker thread's whole life: build per-context container objects (FBOs
+// and a quad VAO are not shared between contexts), then step the board as
+// fast as the GPU completes them, publishing each generation with a fence.
+void Renderer::simThreadMain() {
+    glfwMakeContextCurrent(simWindow);
+
+    float quadVertices[] = { -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f };
+    GLuint vao = 0, vbo = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    GLuint stepFbo[3];
+    glGenFramebuffers(3, stepFbo);
+    for (int i = 0; i < 3; ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, stepFbo[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, boardTriple[i], 0);
     }
-    else {
-        if (gridX >= 0 && gridX < GRID_WIDTH && gridY >= 0 && gridY < GRID_HEIGHT) {
-            float white = 1.0f;
-            glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, gridX, gridY, 1, 1, GL_RED, GL_FLOAT, &white);
-            glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Throttle: wait for the step from two iterations ago before issuing the
+    // next one, so at most two steps are ever queued on the GPU and the
+    // command stream cannot grow without bound at small grid sizes.
+    GLsync throttle[2] = { nullptr, nullptr };
+    int throttleIndex = 0;
+
+    int src = displayedBoard.load();
+    unsigned long long gen = publishedGeneration;
+
+    while (!simThreadStop.load()) {
+        // Board fills forwarded from the main thread (clear / randomize).
+        unsigned int cmd = simCommand.exchange(0);
+        if (cmd != 0) {
+            glBindFramebuffer(GL_FRAMEBUFFER, stepFbo[src]);
+            glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+            if (cmd == 1) {
+                glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            else {
+                randomizeProgram->use();
+                randomizeProgram->setUInt("u_seed", simCommandSeed.load());
+                glBindVertexArray(vao);
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
+            gen = 0;
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            std::lock_guard<std::mutex> lock(publishMutex);
+            if (publishedFence) glDeleteSync(publishedFence);
+            publishedBoard = src;
+            publishedFence = fence;
+            publishedGeneration = gen;
+            continue; // So a fill shows up even while paused
+        }
+
+        if (simPaused.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        if (throttle[throttleIndex]) {
+            glClientWaitSync(throttle[throttleIndex], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(throttle[throttleIndex]);
+            throttle[throttleIndex] = nullptr;
+        }
+
+        // Never write the texture the main thread is drawing from, and order
+        // this step after its last submitted draw (server-side wait only).
+        int dst = (src + 1) % 3;
+        if (dst == displayedBoard.load()) dst = (dst + 1) % 3;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            if (displayFence) {
+                glWaitSync(displayFence, 0, GL_TIMEOUT_IGNORED);
+                glDeleteSync(displayFence);
+                displayFence = nullptr;
+            }
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, stepFbo[dst]);
+        glViewport(0, 0, GRID_WIDTH, GRID_HEIGHT);
+        computeProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, boardTriple[src]);
+        computeProgram->setInt("u_currentState", 0);
+        glBindVertexArray(vao);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        ++gen;
+
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush(); // Push the fence so the main context can wait on it
+        throttle[throttleIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        throttleIndex = 1 - throttleIndex;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            if (publishedFence) glDeleteSync(publishedFence); // Superseded, never shown
+            publishedBoard = dst;
+            publishedFence = fence;
+            publishedGeneration = gen;
         }
+        src = dst;
     }
+
+    for (int i = 0; i < 2; ++i) {
+        if (throttle[i]) glDeleteSync(throttle[i]);
+    }
+    glDeleteFramebuffers(3, stepFbo);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glfwMakeContextCurrent(nullptr);
 }
 
-void Renderer::drawPattern(int centerX, int centerY, const std::vector<std::pair<int, int>>& pattern, int rotation) {
-    float white = 1.0f;
+void Renderer::stopThreadedSimulation() {
+    if (!simThreadRunning.load()) return;
+    simThreadStop.store(true);
+    simThread.join();
+    simThreadRunning.store(false);
+
+    if (publishedFence) {
+        glDeleteSync(publishedFence);
+        publishedFence = nullptr;
+    }
+    if (displayFence) {
+        glDeleteSync(displayFence);
+        displayFence = nullptr;
+    }
+    // Adopt the last published generation when it lives on the ping-pong
+    // pair (the spare texture is about to be deleted anyway).
+    if (publishedBoard == 0 || publishedBoard == 1) {
+        currentTextureIndex = publishedBoard;
+        generationCount = publishedGeneration;
+    }
+    glDeleteTextures(1, &runAheadTexture);
+    runAheadTexture = 0;
+    glfwDestroyWindow(simWindow);
+    simWindow = nullptr;
+}
+
+// Rebuilds the tile work list from the two ping-pong states. Tiles that were
+// not recomputed this step were blit-copied and cannot have changed, so the
+// comparison pass itself is scissored down to the previous work list. The
+// small map is read back synchronously (tilesX*tilesY bytes) and dilated by
+// one tile in every direction, wrapping toroidally like the board.
+void Renderer::updateActivityMap() {
+    const int tw = tilesX(), th = tilesY();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, activityFbo);
+    glViewport(0, 0, tw, th);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    activityProgram->use();
+    glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
-    for (const auto& p : pattern) {
-        int dx = p.first, dy = p.second;
-        int rot_dx = dx, rot_dy = dy;
-        switch (rotation) {
-        case 1: rot_dx = -dy; rot_dy = dx; break;
-        case 2: rot_dx = -dx; rot_dy = -dy; break;
-        case 3: rot_dx = dy; rot_dy = -dx; break;
+    activityProgram->setInt("u_stateA", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, textures[1 - currentTextureIndex]);
+    activityProgram->setInt("u_stateB", 1);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(quadVAO);
+
+    if (activityMapValid) {
+        glEnable(GL_SCISSOR_TEST);
+        for (int ty = 0; ty < th; ++ty) {
+            for (int tx = 0; tx < tw; ++tx) {
+                if (!tileWorkList[ty * tw + tx]) continue;
+                glScissor(tx, ty, 1, 1);
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
         }
-        int finalX = centerX + rot_dx;
-        int finalY = centerY + rot_dy;
-        if (finalX >= 0 && finalX < GRID_WIDTH && finalY >= 0 && finalY < GRID_HEIGHT) {
-            glTexSubImage2D(GL_TEXTURE_2D, 0, finalX, finalY, 1, 1, GL_RED, GL_FLOAT, &white);
+        glDisable(GL_SCISSOR_TEST);
+    }
+    else {
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4); // Full rebuild
+    }
+
+    std::vector<unsigned char> raw(tw * th);
+    glReadPixels(0, 0, tw, th, GL_RED, GL_UNSIGNED_BYTE, raw.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Dilate by one tile so growth out of an active tile is always computed.
+    tileWorkList.assign(tw * th, 0);
+    for (int ty = 0; ty < th; ++ty) {
+        for (int tx = 0; tx < tw; ++tx) {
+            if (!raw[ty * tw + tx]) continue;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = (tx + dx + tw) % tw;
+                    int ny = (ty + dy + th) % th;
+                    tileWorkList[ny * tw + nx] = 1;
+                }
+            }
         }
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
+    activityMapValid = true;
 }
 
-void Renderer::resizeGrid(int newWidth, int newHeight) {
-    // 1. Update the stored dimensions
-    GRID_WIDTH = newWidth;
-    GRID_HEIGHT = newHeight;
-    std::cout << "Resizing grid to " << GRID_WIDTH << "x" << GRID_HEIGHT << std::endl;
+/// Kicks off an asynchronous board readback into a free slot of the PBO ring.
+// The copy into the PBO is queued on the GPU and fenced; nothing blocks here.
+// Packed boards are read as their raw R32UI words, float boards as one byte
+// per cell (the driver converts during the pack).
+void Renderer::requestSnapshot(const std::string& path) {
+    if (simThreadRunning.load()) {
+        std::cout << "Checkpoints are not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (tiledBoard()) {
+        std::cout << "Checkpoints are not yet supported for tiled boards." << std::endl;
+        return;
+    }
+    int slot = -1;
+    for (int i = 0; i < SNAPSHOT_RING_SIZE; ++i) {
+        if (!snapshotFence[i]) { slot = i; break; }
+    }
+    if (slot < 0) {
+        std::cout << "Snapshot ring is full; retry in a frame or two." << std::endl;
+        return;
+    }
 
-    // 2. Clean up the old OpenGL objects that depend on grid size
-    glDeleteFramebuffers(2, fbo);
-    glDeleteTextures(2, textures);
+    const size_t bytes = packedBoard
+        ? static_cast<size_t>(textureWidth()) * GRID_HEIGHT * sizeof(std::uint32_t)
+        : static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT;
 
-    // 3. Re-create the textures and framebuffers with the new size
-    //    (Our existing init functions work perfectly for this)
-    initTextures();
-    initFramebuffers();
+    if (!snapshotPbo[slot]) glGenBuffers(1, &snapshotPbo[slot]);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, snapshotPbo[slot]);
+    glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (packedBoard) {
+        glReadPixels(0, 0, textureWidth(), GRID_HEIGHT, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+    else {
+        glReadPixels(0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    snapshotFence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    snapshotPath[slot] = path;
+    snapshotGeneration[slot] = generationCount;
+    std::cout << "Checkpoint queued: " << path << std::endl;
+}
+
+// Collects any snapshot readback whose fence has signaled: maps the PBO,
+// hands the buffer to the writer thread, and frees the ring slot. A zero
+// timeout means a still-busy slot just stays in flight until a later frame.
+void Renderer::pollSnapshots() {
+    for (int i = 0; i < SNAPSHOT_RING_SIZE; ++i) {
+        if (!snapshotFence[i]) continue;
+        GLenum status = glClientWaitSync(snapshotFence[i], 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+
+        const size_t bytes = packedBoard
+            ? static_cast<size_t>(textureWidth()) * GRID_HEIGHT * sizeof(std::uint32_t)
+            : static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT;
+
+        SnapshotWriter::Job job;
+        job.path = snapshotPath[i];
+        job.width = GRID_WIDTH;
+        job.height = GRID_HEIGHT;
+        job.generation = snapshotGeneration[i];
+        job.seed = boardSeed;
+        job.packedWords = packedBoard;
+        job.data.resize(bytes);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, snapshotPbo[i]);
+        void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+        if (mapped) {
+            std::memcpy(job.data.data(), mapped, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            snapshotWriter->enqueue(std::move(job));
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glDeleteSync(snapshotFence[i]);
+        snapshotFence[i] = nullptr;
+        snapshotPath[i].clear();
+    }
+}
+
+void Renderer::startFrameExport(const std::string& directory, int everyN) {
+    if (everyN <= 0) return;
+    if (tiledBoard()) {
+        std::cout << "Frame export is not yet supported for tiled boards." << std::endl;
+        return;
+    }
+    if (simThreadRunning.load()) {
+        std::cout << "Frame export is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+
+    frameExporter = std::make_unique<FrameExporter>(directory); // Throws on bad paths
+    exportEvery = everyN;
+    exportNextCaptureGen = generationCount; // Capture the current board first
+
+    // Preallocate the ring; reusing fixed-size buffers avoids per-capture
+    // reallocation in the driver.
+    const size_t bytes = packedBoard
+        ? static_cast<size_t>(textureWidth()) * GRID_HEIGHT * sizeof(std::uint32_t)
+        : static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT;
+    for (int i = 0; i < EXPORT_RING_SIZE; ++i) {
+        glGenBuffers(1, &exportPbo[i]);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, exportPbo[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-    // 4. Initialize the new grid with a fresh state
-    randomizeBoard();
+    std::cout << "Frame export ON: every " << exportEvery
+        << (exportEvery == 1 ? "st" : "th") << " generation to " << directory << "/." << std::endl;
+}
+
+// Per-step export bookkeeping, called from both step variants before they
+// advance the generation count. Polling here keeps the ring draining in
+// benchmark mode too, where nothing else runs between steps. The capture
+// test is a threshold, not a modulo, so the fused double step can only land
+// on or past a due point, never skip it; odd cadences then drift by at most
+// one generation instead of silently dropping frames.
+void Renderer::serviceFrameExport() {
+    pollExportFrames();
+    if (exportNextCaptureGen > generationCount + exportEvery) {
+        // A board reset moved the generation count backwards; re-anchor
+        // rather than waiting out the stale threshold.
+        exportNextCaptureGen = generationCount;
+    }
+    if (generationCount >= exportNextCaptureGen) {
+        captureExportFrame();
+        exportNextCaptureGen = generationCount + exportEvery;
+    }
+}
+
+// Kicks an asynchronous readback of the current board into a free ring
+// slot. When all slots are still in flight the frame is dropped rather than
+// stalling the step loop; the drop count is reported at shutdown.
+void Renderer::captureExportFrame() {
+    int slot = -1;
+    for (int i = 0; i < EXPORT_RING_SIZE; ++i) {
+        if (!exportFence[i]) { slot = i; break; }
+    }
+    if (slot < 0) {
+        ++exportRingDrops;
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, exportPbo[slot]);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (packedBoard) {
+        glReadPixels(0, 0, textureWidth(), GRID_HEIGHT, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+    else {
+        glReadPixels(0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    exportFence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    exportFrameGen[slot] = generationCount;
+}
+
+// Collects finished export readbacks and hands them to the encoder pool.
+// Zero-timeout waits: a still-busy slot simply stays in flight.
+void Renderer::pollExportFrames() {
+    for (int i = 0; i < EXPORT_RING_SIZE; ++i) {
+        if (!exportFence[i]) continue;
+        GLenum status = glClientWaitSync(exportFence[i], 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+
+        const size_t bytes = packedBoard
+            ? static_cast<size_t>(textureWidth()) * GRID_HEIGHT * sizeof(std::uint32_t)
+            : static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT;
+
+        FrameExporter::Job job;
+        job.generation = exportFrameGen[i];
+        job.width = GRID_WIDTH;
+        job.height = GRID_HEIGHT;
+        job.packedWords = packedBoard;
+        job.data.resize(bytes);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, exportPbo[i]);
+        void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+        if (mapped) {
+            std::memcpy(job.data.data(), mapped, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            frameExporter->enqueue(std::move(job)); // Drops are counted inside
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glDeleteSync(exportFence[i]);
+        exportFence[i] = nullptr;
+    }
+}
+
+void Renderer::stopFrameExport() {
+    if (!frameExporter) return;
+
+    // Flush the last in-flight captures, then let the exporter drain.
+    glFinish();
+    pollExportFrames();
+    if (exportRingDrops > 0) {
+        std::cout << "Frame export: " << exportRingDrops
+            << " frames dropped at the readback ring (GPU backpressure)." << std::endl;
+    }
+    frameExporter.reset(); // Joins the encoders and prints written/dropped totals
+
+    for (int i = 0; i < EXPORT_RING_SIZE; ++i) {
+        if (exportFence[i]) { glDeleteSync(exportFence[i]); exportFence[i] = nullptr; }
+        if (exportPbo[i]) { glDeleteBuffers(1, &exportPbo[i]); exportPbo[i] = 0; }
+    }
+}
+
+// Restores a checkpoint: resizes the grid to the stored dimensions if they
+// differ, uploads the decoded board in one sub-image transfer, and picks up
+// the generation count and seed from the header.
+void Renderer::loadCheckpoint(const std::string& path) {
+    if (simThreadRunning.load()) {
+        std::cout << "Checkpoints are not available with threaded run-ahead." << std::endl;
+        return;
+    }
+
+    Checkpoint checkpoint = CheckpointFile::load(path); // Throws on bad files
+
+    if (checkpoint.width != GRID_WIDTH || checkpoint.height != GRID_HEIGHT) {
+        resizeGrid(checkpoint.width, checkpoint.height);
+    }
+
+    if (GRID_WIDTH == checkpoint.width && GRID_HEIGHT == checkpoint.height) {
+        uploadBoardCells(checkpoint.cells);
+    }
+    else {
+        // The packed board rounds its width up to a multiple of 32; pad the
+        // checkpoint rows with dead cells on the right.
+        std::vector<unsigned char> padded(static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT, 0);
+        for (int y = 0; y < checkpoint.height; ++y) {
+            std::memcpy(&padded[static_cast<size_t>(y) * GRID_WIDTH],
+                &checkpoint.cells[static_cast<size_t>(y) * checkpoint.width],
+                checkpoint.width);
+        }
+        uploadBoardCells(padded);
+    }
+
+    generationCount = checkpoint.generation;
+    boardSeed = checkpoint.seed;
+    std::cout << "Checkpoint loaded: " << path << " (" << checkpoint.width << "x" << checkpoint.height
+        << ", generation " << checkpoint.generation << ")" << std::endl;
+}
+
+// Population counting as a mipmap reduction: glGenerateMipmap averages the
+// board down to a single texel, and average * cell count = live cells. The
+// 1x1 top level is copied into a PBO and collected a frame or two later once
+// its fence signals, so the render thread never waits on the GPU. (For grids
+// that are not powers of two the driver's box filter makes the count a very
+// close approximation rather than exact.)
+void Renderer::updateStatistics() {
+    if (packedBoard) return; // Integer board has no averageable mip chain
+    if (tiledBoard()) return; // No single mip chain spans the tile array
+    if (simThreadRunning.load()) return; // The mip reduction would race the worker
+
+    // Collect the oldest pending readback if its fence has signaled.
+    int readIndex = 1 - statsWriteIndex;
+    if (statsFence[readIndex]) {
+        GLenum status = glClientWaitSync(statsFence[readIndex], 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            glDeleteSync(statsFence[readIndex]);
+            statsFence[readIndex] = nullptr;
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, statsPbo[readIndex]);
+            const float* average = static_cast<const float*>(
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(float), GL_MAP_READ_BIT));
+            if (average) {
+                long long newPopulation = std::llround(static_cast<double>(*average) * GRID_WIDTH * GRID_HEIGHT);
+                if (population >= 0) {
+                    populationDelta = newPopulation - population;
+                }
+                population = newPopulation;
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+    }
+
+    // Issue a new reduction into the other PBO if it is free.
+    if (!statsFence[statsWriteIndex]) {
+        refreshMipmaps();
+        glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+        int topLevel = static_cast<int>(std::floor(std::log2(std::max(GRID_WIDTH, GRID_HEIGHT))));
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, statsPbo[statsWriteIndex]);
+        glGetTexImage(GL_TEXTURE_2D, topLevel, GL_RED, GL_FLOAT, nullptr);
+        statsFence[statsWriteIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        statsWriteIndex = 1 - statsWriteIndex;
+    }
+}
+
+// Builds the stabilization detector. Declined for tiled boards, like the
+// population counter: no single mip chain spans the tile array. The packed
+// board gets its own shader variant that folds whole words into the checksum.
+void Renderer::enableAutoStop() {
+    if (tiledBoard()) {
+        std::cout << "Auto-stop is not available for tiled boards." << std::endl;
+        return;
+    }
+    signatureProgram = std::make_unique<Shader>("shaders/compute.vert",
+        packedBoard ? "shaders/signature_packed.frag" : "shaders/signature.frag");
+    initSignatureResources();
+    autoStopEnabled = true;
+    std::cout << "Auto-stop enabled: checking for stabilization every "
+        << STABILITY_CHECK_INTERVAL << " generations." << std::endl;
+}
+
+// (Re)creates the signature render target at the current grid size and drops
+// any in-flight readbacks (their samples belong to the old board).
+void Renderer::initSignatureResources() {
+    if (signatureFbo) glDeleteFramebuffers(1, &signatureFbo);
+    if (signatureTex) glDeleteTextures(1, &signatureTex);
+    for (int i = 0; i < 2; ++i) {
+        if (signatureFence[i]) {
+            glDeleteSync(signatureFence[i]);
+            signatureFence[i] = nullptr;
+        }
+    }
+
+    glGenTextures(1, &signatureTex);
+    glBindTexture(GL_TEXTURE_2D, signatureTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, textureWidth(), GRID_HEIGHT, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenerateMipmap(GL_TEXTURE_2D); // Allocate the chain up front
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &signatureFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, signatureFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, signatureTex, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!signaturePbo[0]) {
+        glGenBuffers(2, signaturePbo);
+        for (int i = 0; i < 2; ++i) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, signaturePbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(float), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+}
+
+// Re-arms the detector: clears the latch, the candidate period, and the
+// sample window. Called whenever the board is replaced or the user resumes
+// after an auto-pause.
+void Renderer::resetStabilization() {
+    stabilized = false;
+    pendingPeriod = 0;
+    signatureHistory.clear();
+}
+
+// Collects any signature readback whose fence has signaled and, on sample
+// generations, issues a new checksum reduction over the completed board.
+// Detection costs one full-board pass plus a mip reduction every
+// STABILITY_CHECK_INTERVAL generations - a few percent at worst - and the
+// readback arrives a frame or two later through the fenced PBO pair, so the
+// pipeline never stalls. Signatures are compared bit-exactly: identical
+// boards reduce to the identical float, and near-misses are exactly what
+// must not match.
+void Renderer::checkStabilization() {
+    for (int i = 0; i < 2; ++i) {
+        if (!signatureFence[i]) continue;
+        GLenum status = glClientWaitSync(signatureFence[i], 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(signatureFence[i]);
+        signatureFence[i] = nullptr;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, signaturePbo[i]);
+        const float* value = static_cast<const float*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(float), GL_MAP_READ_BIT));
+        if (value) {
+            float signature = *value;
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+            // A match in the window gives a candidate period; two matches in
+            // a row at the same spacing make it a verdict. The second look
+            // filters out one-off float-average collisions.
+            unsigned long long matchDistance = 0;
+            for (auto it = signatureHistory.rbegin(); it != signatureHistory.rend(); ++it) {
+                if (it->value == signature) {
+                    matchDistance = signatureGen[i] - it->generation;
+                    break;
+                }
+            }
+            if (matchDistance > 0 && matchDistance == pendingPeriod && !stabilized) {
+                stabilized = true;
+                std::cout << "Board stabilized at generation " << signatureGen[i]
+                    << " (period divides " << matchDistance << ")." << std::endl;
+            }
+            pendingPeriod = matchDistance;
+
+            signatureHistory.push_back({ signatureGen[i], signature });
+            if (signatureHistory.size() > SIGNATURE_WINDOW) {
+                signatureHistory.erase(signatureHistory.begin());
+            }
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    if (generationCount % STABILITY_CHECK_INTERVAL != 0) return;
+    if (signatureFence[signatureWriteIndex]) return; // Both slots still in flight
+
+    // Checksum pass over the completed board, mip reduction to 1x1, then an
+    // asynchronous readback of that single texel.
+    glBindFramebuffer(GL_FRAMEBUFFER, signatureFbo);
+    glViewport(0, 0, textureWidth(), GRID_HEIGHT);
+    signatureProgram->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+    signatureProgram->setInt("u_board", 0);
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, signatureTex);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    int topLevel = static_cast<int>(std::floor(std::log2(std::max(textureWidth(), GRID_HEIGHT))));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, signaturePbo[signatureWriteIndex]);
+    glGetTexImage(GL_TEXTURE_2D, topLevel, GL_RED, GL_FLOAT, nullptr);
+    signatureFence[signatureWriteIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    signatureGen[signatureWriteIndex] = generationCount;
+    signatureWriteIndex = 1 - signatureWriteIndex;
+}
+
+// Regenerates the current texture's mip chain if the board has changed since
+// the chain was last built. Shared by the statistics reduction and the
+// zoomed-out LOD draw path, so the pyramid costs one reduction per
+// generation no matter how many consumers there are.
+void Renderer::refreshMipmaps() {
+    if (mipmapRevision == boardRevision) return;
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    mipmapRevision = boardRevision;
+}
+
+void Renderer::drawToScreen() {
+    // Threaded run-ahead: adopt the newest generation the worker published.
+    // The server-side wait orders our texture fetches after the step that
+    // produced it without ever blocking the CPU.
+    GLuint boardTexture = textures[currentTextureIndex];
+    if (simThreadRunning.load()) {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        if (publishedFence) {
+            glWaitSync(publishedFence, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(publishedFence);
+            publishedFence = nullptr;
+        }
+        if (publishedBoard >= 0) {
+            displayedBoard.store(publishedBoard);
+            generationCount = publishedGeneration;
+        }
+        boardTexture = boardTriple[displayedBoard.load()];
+    }
+
+    // Zoomed-out LOD: once a screen pixel covers more than ~2 cells, sample
+    // an averaged mip level instead of GL_NEAREST point samples. The value
+    // read is then local live-cell density, so the overview neither flickers
+    // nor thrashes the texture cache, and its cost scales with window pixels.
+    // Skipped with threaded run-ahead: the mip refresh would race the worker.
+    float lod = 0.0f;
+    if (!packedBoard && !tiledBoard() && !simThreadRunning.load()) {
+        float cellsPerPixel = std::max(GRID_WIDTH / (zoom * windowWidth),
+            GRID_HEIGHT / (zoom * windowHeight));
+        if (cellsPerPixel > 2.0f) {
+            int topLevel = static_cast<int>(std::floor(std::log2(std::max(GRID_WIDTH, GRID_HEIGHT))));
+            lod = std::min(std::log2(cellsPerPixel), static_cast<float>(topLevel));
+            refreshMipmaps();
+        }
+    }
+
+    // High-zoom instanced path: once a cell covers at least ~8 screen
+    // pixels, draw one inset quad per visible cell instead of point-sampling
+    // the board per pixel. The vertex stage fetches each cell exactly once
+    // and the inset gaps read as grid lines, so editing zoom levels get a
+    // legible lattice at a cost of O(visible cells) - putting the lines in
+    // draw.frag would tax every pixel at every zoom instead.
+    bool instancedCells = false;
+    int cellRectX = 0, cellRectY = 0, cellRectW = 0, cellRectH = 0;
+    if (cellsProgram && !tiledBoard() && lod == 0.0f) {
+        float windowAspect = static_cast<float>(windowWidth) / windowHeight;
+        float gridAspect = static_cast<float>(GRID_WIDTH) / GRID_HEIGHT;
+        float scaleX = windowAspect > gridAspect ? gridAspect / windowAspect : 1.0f;
+        float scaleY = windowAspect > gridAspect ? 1.0f : windowAspect / gridAspect;
+        float pxPerCellX = windowWidth * scaleX * zoom / GRID_WIDTH;
+        float pxPerCellY = windowHeight * scaleY * zoom / GRID_HEIGHT;
+        if (std::min(pxPerCellX, pxPerCellY) >= 8.0f) {
+            // Visible cell rectangle from the same pan/zoom mapping the
+            // shaders use, clamped to the board.
+            cellRectX = std::max(static_cast<int>(std::floor(panX * GRID_WIDTH)), 0);
+            cellRectY = std::max(static_cast<int>(std::floor(panY * GRID_HEIGHT)), 0);
+            int x1 = std::min(static_cast<int>(std::ceil((panX + 1.0f / zoom) * GRID_WIDTH)) + 1, GRID_WIDTH);
+            int y1 = std::min(static_cast<int>(std::ceil((panY + 1.0f / zoom) * GRID_HEIGHT)) + 1, GRID_HEIGHT);
+            cellRectW = x1 - cellRectX;
+            cellRectH = y1 - cellRectY;
+            instancedCells = cellRectW > 0 && cellRectH > 0;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+    glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (tiledBoard()) {
+        drawTiledProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures[currentTextureIndex]);
+        drawTiledProgram->setInt("u_screenTexture", 0);
+        drawTiledProgram->setInt("u_tileSize", tileSize);
+        drawTiledProgram->setInt("u_tileCols", tileCols);
+    }
+    else if (instancedCells) {
+        cellsProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, boardTexture); // texelFetch; filter mode is irrelevant
+        cellsProgram->setInt("u_board", 0);
+        cellsProgram->setInt("u_rectX", cellRectX);
+        cellsProgram->setInt("u_rectY", cellRectY);
+        cellsProgram->setInt("u_rectW", cellRectW);
+    }
+    else {
+        drawProgram->use();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, boardTexture);
+        if (!packedBoard) {
+            // textureLod needs a mipmap-capable filter; point sampling otherwise.
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                lod > 0.0f ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+        }
+        drawProgram->setInt("u_screenTexture", 0);
+    }
+
+    // One buffer update replaces the per-uniform glUniform calls. The ring
+    // advances a slot each frame so an in-flight frame's parameters are
+    // never overwritten under it.
+    const ViewParams params = {
+        { panX, panY },
+        { (float)windowWidth, (float)windowHeight },
+        { (float)GRID_WIDTH, (float)GRID_HEIGHT },
+        zoom,
+        lod
+    };
+    if (viewUboPtr) {
+        viewUboSlot = (viewUboSlot + 1) % VIEW_UBO_SLOTS;
+        std::memcpy(viewUboPtr + static_cast<size_t>(viewUboSlot) * viewUboStride, &params, sizeof(params));
+        glBindBufferRange(GL_UNIFORM_BUFFER, 0, viewUbo,
+            static_cast<GLintptr>(viewUboSlot) * viewUboStride, viewUboStride);
+    }
+    else {
+        glBindBuffer(GL_UNIFORM_BUFFER, viewUbo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(params), &params);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    glBindVertexArray(quadVAO);
+    if (instancedCells) {
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, cellRectW * cellRectH);
+    }
+    else {
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+
+    // Hand the worker a fence for this draw so it never overwrites the
+    // texture a still-executing frame is sampling from.
+    if (simThreadRunning.load()) {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        if (displayFence) glDeleteSync(displayFence);
+        displayFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+}
+
+void Renderer::handleMouseDrawing(bool isLeftMouseDrag, const std::pair<double, double>& mousePos, bool isGliderMode, int gliderRotation) {
+    if (simThreadRunning.load()) return; // Cell edits would race the worker's steps
+
+    if (!isLeftMouseDrag) {
+        strokeActive = false;
+        return;
+    }
+
+    // THIS FUNCTION IS NOW SIMPLER
+    // We get the final texture coordinate directly from our corrected conversion function.
+    auto texCoords = screenToTextureCoords(mousePos.first, mousePos.second);
+
+    if (texCoords.first < 0.f || texCoords.first > 1.f || texCoords.second < 0.f || texCoords.second > 1.f) {
+        strokeActive = false; // Click was outside the valid grid area; break the stroke
+        return;
+    }
+
+    int gridX = static_cast<int>(texCoords.first * GRID_WIDTH);
+    int gridY = static_cast<int>(texCoords.second * GRID_HEIGHT);
+
+    if (isGliderMode) {
+        static const std::vector<std::pair<int, int>> gliderPattern = { {1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2} };
+        drawPattern(gridX, gridY, gliderPattern, gliderRotation);
+        strokeActive = false;
+        return;
+    }
+
+    // Join this sample to the previous frame's with a Bresenham line, stamp
+    // the brush footprint at every line cell, and flush the segment as one
+    // batched upload. One sample per frame used to mean gaps in fast strokes
+    // and one full bind/upload/unbind round-trip per painted cell.
+    int x0 = strokeActive ? strokeLastX : gridX;
+    int y0 = strokeActive ? strokeLastY : gridY;
+    strokeLastX = gridX;
+    strokeLastY = gridY;
+    strokeActive = true;
+
+    int lo = -(brushSize - 1) / 2;
+    int hi = brushSize / 2;
+    std::vector<std::pair<int, int>> cells;
+
+    int dx = std::abs(gridX - x0), sx = x0 < gridX ? 1 : -1;
+    int dy = -std::abs(gridY - y0), sy = y0 < gridY ? 1 : -1;
+    int err = dx + dy;
+    int x = x0, y = y0;
+    for (;;) {
+        for (int by = lo; by <= hi; ++by) {
+            for (int bx = lo; bx <= hi; ++bx) {
+                cells.emplace_back(x + bx, y + by);
+            }
+        }
+        if (x == gridX && y == gridY) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x += sx; }
+        if (e2 <= dx) { err += dx; y += sy; }
+    }
+    paintCells(cells);
+}
+
+void Renderer::adjustBrushSize(int delta) {
+    brushSize = std::clamp(brushSize + delta, 1, 64);
+    std::cout << "Brush size: " << brushSize << "x" << brushSize << std::endl;
+}
+
+// Returns a persistently-mapped staging slot with room for `bytes` whose
+// previous transfer (if any) has completed, or null when ARB_buffer_storage
+// is unavailable (or mapping fails) so callers take the transient-vector
+// path. Slots are created lazily and regrown when the request outgrows them;
+// in steady state every acquire is just a fence check.
+Renderer::StagingBuffer* Renderer::acquireStagingBuffer(size_t bytes) {
+    if (!GLEW_ARB_buffer_storage) return nullptr;
+
+    // Prefer a slot that is already idle; with three slots and the transfer
+    // rates these paths see, waiting is the rare case.
+    StagingBuffer* chosen = nullptr;
+    for (auto& slot : stagingPool) {
+        if (!slot.fence) {
+            chosen = &slot;
+            break;
+        }
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            chosen = &slot;
+            break;
+        }
+    }
+    if (!chosen) {
+        chosen = &stagingPool[0];
+        glClientWaitSync(chosen->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(chosen->fence);
+        chosen->fence = nullptr;
+    }
+
+    if (chosen->capacity < bytes) {
+        if (chosen->buffer) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, chosen->buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glDeleteBuffers(1, &chosen->buffer);
+        }
+        glGenBuffers(1, &chosen->buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, chosen->buffer);
+        // Coherent writes: CPU stores are visible to the transfer without an
+        // explicit flush, and the per-slot fence provides all the ordering.
+        // The read bit matters too: the merge paths glReadPixels into the
+        // mapping and read-modify-write it, which is undefined through a
+        // write-only mapping and would hit uncached write-combined memory
+        // even where it happens to work.
+        GLbitfield storageFlags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, storageFlags);
+        chosen->ptr = static_cast<unsigned char*>(
+            glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, storageFlags));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!chosen->ptr) {
+            glDeleteBuffers(1, &chosen->buffer);
+            chosen->buffer = 0;
+            chosen->capacity = 0;
+            return nullptr;
+        }
+        chosen->capacity = bytes;
+    }
+    return chosen;
+}
+
+// Marks a staging slot as in flight. Callers fence immediately after the
+// glTexSubImage call that sources from the slot.
+void Renderer::fenceStagingBuffer(StagingBuffer& staging) {
+    if (staging.fence) glDeleteSync(staging.fence);
+    staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void Renderer::destroyStagingPool() {
+    for (auto& slot : stagingPool) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        if (slot.buffer) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &slot.buffer);
+            slot.buffer = 0;
+            slot.ptr = nullptr;
+            slot.capacity = 0;
+        }
+    }
+}
+
+// Flushes one frame's worth of brush cells with two driver calls, like
+// stampPattern: one glReadPixels over the cells' bounding rectangle and one
+// glTexSubImage2D writing it back with the painted cells merged in.
+void Renderer::paintCells(const std::vector<std::pair<int, int>>& cells) {
+    if (cells.empty()) return;
+
+    if (tiledBoard()) {
+        // Strokes can straddle tile seams; per-cell uploads keep this simple
+        // and interactive brushes are small enough that the round-trips do
+        // not matter.
+        for (const auto& c : cells) {
+            setCell(c.first, c.second, true);
+        }
+        return;
+    }
+
+    int minX = cells[0].first, maxX = cells[0].first;
+    int minY = cells[0].second, maxY = cells[0].second;
+    for (const auto& c : cells) {
+        minX = std::min(minX, c.first);
+        maxX = std::max(maxX, c.first);
+        minY = std::min(minY, c.second);
+        maxY = std::max(maxY, c.second);
+    }
+
+    // Clip the bounding rectangle against the board.
+    int rx = std::max(minX, 0);
+    int ry = std::max(minY, 0);
+    int rw = std::min(maxX + 1, GRID_WIDTH) - rx;
+    int rh = std::min(maxY + 1, GRID_HEIGHT) - ry;
+    if (rw <= 0 || rh <= 0) return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+
+    if (packedBoard) {
+        // Work on the word-aligned rectangle covering the clipped region.
+        int wordX0 = rx / 32;
+        int wordX1 = (rx + rw - 1) / 32;
+        int wordCount = wordX1 - wordX0 + 1;
+        size_t wordTotal = static_cast<size_t>(wordCount) * rh;
+        StagingBuffer* staging = acquireStagingBuffer(wordTotal * sizeof(GLuint));
+        std::vector<GLuint> fallback;
+        GLuint* words;
+        if (staging) {
+            words = reinterpret_cast<GLuint*>(staging->ptr);
+        }
+        else {
+            fallback.resize(wordTotal);
+            words = fallback.data();
+        }
+        glReadPixels(wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, words);
+
+        for (const auto& c : cells) {
+            if (c.first < rx || c.first >= rx + rw || c.second < ry || c.second >= ry + rh) continue;
+            if (mutationLog) mutationLog->recordCell(generationCount, c.first, c.second, true);
+            words[static_cast<size_t>(c.second - ry) * wordCount + (c.first / 32 - wordX0)] |= (1u << (c.first % 32));
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, words);
+        }
+    }
+    else {
+        size_t cellTotal = static_cast<size_t>(rw) * rh;
+        StagingBuffer* staging = acquireStagingBuffer(cellTotal * sizeof(float));
+        std::vector<float> fallback;
+        float* region;
+        if (staging) {
+            region = reinterpret_cast<float*>(staging->ptr);
+        }
+        else {
+            fallback.resize(cellTotal);
+            region = fallback.data();
+        }
+        glReadPixels(rx, ry, rw, rh, GL_RED, GL_FLOAT, region);
+
+        for (const auto& c : cells) {
+            if (c.first < rx || c.first >= rx + rw || c.second < ry || c.second >= ry + rh) continue;
+            if (mutationLog) mutationLog->recordCell(generationCount, c.first, c.second, true);
+            region[static_cast<size_t>(c.second - ry) * rw + (c.first - rx)] = 1.0f;
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rx, ry, rw, rh, GL_RED, GL_FLOAT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rx, ry, rw, rh, GL_RED, GL_FLOAT, region);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    activityMapValid = false;
+    ++boardRevision;
+}
+
+// Sets a single cell. In packed mode the containing 32-bit word is read back
+// from the FBO, the bit is modified, and the word is re-uploaded.
+void Renderer::setCell(int x, int y, bool alive) {
+    if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= GRID_HEIGHT) return;
+    if (mutationLog) mutationLog->recordCell(generationCount, x, y, alive);
+
+    if (tiledBoard()) {
+        float state = alive ? 1.0f : 0.0f;
+        int layer = (y / tileSize) * tileCols + (x / tileSize);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures[currentTextureIndex]);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x % tileSize, y % tileSize, layer,
+            1, 1, 1, GL_RED, GL_FLOAT, &state);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        activityMapValid = false;
+        ++boardRevision;
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+    if (packedBoard) {
+        GLuint word = 0;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+        glReadPixels(x / 32, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, &word);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        if (alive) word |= (1u << (x % 32));
+        else word &= ~(1u << (x % 32));
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x / 32, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, &word);
+    }
+    else {
+        float state = alive ? 1.0f : 0.0f;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RED, GL_FLOAT, &state);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    activityMapValid = false;
+    ++boardRevision;
+}
+
+void Renderer::drawPattern(int centerX, int centerY, const std::vector<std::pair<int, int>>& pattern, int rotation) {
+    for (const auto& p : pattern) {
+        int dx = p.first, dy = p.second;
+        int rot_dx = dx, rot_dy = dy;
+        switch (rotation) {
+        case 1: rot_dx = -dy; rot_dy = dx; break;
+        case 2: rot_dx = -dx; rot_dy = -dy; break;
+        case 3: rot_dx = dy; rot_dy = -dx; break;
+        }
+        setCell(centerX + rot_dx, centerY + rot_dy, true);
+    }
+}
+
+// Stamps a pattern with two driver calls total: one glReadPixels to fetch the
+// affected rectangle and one glTexSubImage2D to write it back with the
+// pattern's live cells merged in. drawPattern()-style per-cell uploads would
+// be thousands of round-trips for the large library patterns this is for.
+void Renderer::stampPattern(int centerX, int centerY, const Pattern& pattern) {
+    if (pattern.width <= 0 || pattern.height <= 0) return;
+    if (simThreadRunning.load()) {
+        std::cout << "Pattern stamping is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+
+    if (tiledBoard()) {
+        // Patterns can straddle tile seams; per-cell uploads keep this simple
+        // and stamping is rare enough that the round-trips do not matter.
+        int originX = centerX - pattern.width / 2;
+        int originY = centerY - pattern.height / 2;
+        for (const auto& cell : pattern.cells) {
+            setCell(originX + cell.first, originY + (pattern.height - 1 - cell.second), true);
+        }
+        std::cout << "Stamped \"" << pattern.name << "\" (" << pattern.cells.size() << " cells)." << std::endl;
+        return;
+    }
+
+    // Pattern cell (px, py) has py = 0 at the top; board y grows upward.
+    int originX = centerX - pattern.width / 2;
+    int originY = centerY - pattern.height / 2;
+
+    // Clip the pattern's bounding box against the board.
+    int rx = std::max(originX, 0);
+    int ry = std::max(originY, 0);
+    int rw = std::min(originX + pattern.width, GRID_WIDTH) - rx;
+    int rh = std::min(originY + pattern.height, GRID_HEIGHT) - ry;
+    if (rw <= 0 || rh <= 0) {
+        std::cout << "Pattern lies entirely outside the board." << std::endl;
+        return;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+
+    if (packedBoard) {
+        // Work on the word-aligned rectangle covering the clipped region.
+        int wordX0 = rx / 32;
+        int wordX1 = (rx + rw - 1) / 32;
+        int wordCount = wordX1 - wordX0 + 1;
+        size_t wordTotal = static_cast<size_t>(wordCount) * rh;
+        StagingBuffer* staging = acquireStagingBuffer(wordTotal * sizeof(GLuint));
+        std::vector<GLuint> fallback;
+        GLuint* words;
+        if (staging) {
+            words = reinterpret_cast<GLuint*>(staging->ptr);
+        }
+        else {
+            fallback.resize(wordTotal);
+            words = fallback.data();
+        }
+        glReadPixels(wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, words);
+
+        for (const auto& cell : pattern.cells) {
+            int bx = originX + cell.first;
+            int by = originY + (pattern.height - 1 - cell.second);
+            if (bx < rx || bx >= rx + rw || by < ry || by >= ry + rh) continue;
+            if (mutationLog) mutationLog->recordCell(generationCount, bx, by, true);
+            words[(by - ry) * wordCount + (bx / 32 - wordX0)] |= (1u << (bx % 32));
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, wordX0, ry, wordCount, rh, GL_RED_INTEGER, GL_UNSIGNED_INT, words);
+        }
+    }
+    else {
+        size_t cellTotal = static_cast<size_t>(rw) * rh;
+        StagingBuffer* staging = acquireStagingBuffer(cellTotal * sizeof(float));
+        std::vector<float> fallback;
+        float* cells;
+        if (staging) {
+            cells = reinterpret_cast<float*>(staging->ptr);
+        }
+        else {
+            fallback.resize(cellTotal);
+            cells = fallback.data();
+        }
+        glReadPixels(rx, ry, rw, rh, GL_RED, GL_FLOAT, cells);
+
+        for (const auto& cell : pattern.cells) {
+            int bx = originX + cell.first;
+            int by = originY + (pattern.height - 1 - cell.second);
+            if (bx < rx || bx >= rx + rw || by < ry || by >= ry + rh) continue;
+            if (mutationLog) mutationLog->recordCell(generationCount, bx, by, true);
+            cells[(by - ry) * rw + (bx - rx)] = 1.0f;
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rx, ry, rw, rh, GL_RED, GL_FLOAT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rx, ry, rw, rh, GL_RED, GL_FLOAT, cells);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    activityMapValid = false;
+    ++boardRevision;
+    std::cout << "Stamped \"" << pattern.name << "\" (" << pattern.cells.size() << " cells)." << std::endl;
+}
+
+// Reads the whole board back as row-major 0/1 bytes. A full synchronous
+// round-trip - only used by explicit, CPU-side operations like HashLife.
+std::vector<unsigned char> Renderer::readBoardCells() {
+    std::vector<unsigned char> cells(static_cast<size_t>(GRID_WIDTH) * GRID_HEIGHT);
+
+    if (tiledBoard()) {
+        // Read each layer's board-covering region through a per-layer attach.
+        for (int t = 0; t < tileCols * tileRows; ++t) {
+            int ox = (t % tileCols) * tileSize;
+            int oy = (t / tileCols) * tileSize;
+            int w = std::min(tileSize, GRID_WIDTH - ox);
+            int h = std::min(tileSize, GRID_HEIGHT - oy);
+            if (w <= 0 || h <= 0) continue;
+
+            attachTileLayer(fbo[currentTextureIndex], textures[currentTextureIndex], t);
+            std::vector<float> data(static_cast<size_t>(w) * h);
+            glReadPixels(0, 0, w, h, GL_RED, GL_FLOAT, data.data());
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    cells[static_cast<size_t>(oy + y) * GRID_WIDTH + ox + x] =
+                        data[static_cast<size_t>(y) * w + x] > 0.5f ? 1 : 0;
+                }
+            }
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return cells;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[currentTextureIndex]);
+    if (packedBoard) {
+        std::vector<GLuint> words(static_cast<size_t>(textureWidth()) * GRID_HEIGHT);
+        glReadPixels(0, 0, textureWidth(), GRID_HEIGHT, GL_RED_INTEGER, GL_UNSIGNED_INT, words.data());
+        for (int y = 0; y < GRID_HEIGHT; ++y) {
+            for (int x = 0; x < GRID_WIDTH; ++x) {
+                GLuint word = words[static_cast<size_t>(y) * textureWidth() + x / 32];
+                cells[static_cast<size_t>(y) * GRID_WIDTH + x] = (word >> (x % 32)) & 1u;
+            }
+        }
+    }
+    else {
+        std::vector<float> data(cells.size());
+        glReadPixels(0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_FLOAT, data.data());
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i] = data[i] > 0.5f ? 1 : 0;
+        }
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return cells;
+}
+
+// Uploads a full row-major 0/1 board in a single sub-image transfer.
+void Renderer::uploadBoardCells(const std::vector<unsigned char>& cells) {
+    if (tiledBoard()) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures[currentTextureIndex]);
+        for (int t = 0; t < tileCols * tileRows; ++t) {
+            int ox = (t % tileCols) * tileSize;
+            int oy = (t / tileCols) * tileSize;
+            int w = std::min(tileSize, GRID_WIDTH - ox);
+            int h = std::min(tileSize, GRID_HEIGHT - oy);
+            if (w <= 0 || h <= 0) continue;
+
+            std::vector<float> data(static_cast<size_t>(w) * h);
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    data[static_cast<size_t>(y) * w + x] =
+                        cells[static_cast<size_t>(oy + y) * GRID_WIDTH + ox + x] ? 1.0f : 0.0f;
+                }
+            }
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, t, w, h, 1, GL_RED, GL_FLOAT, data.data());
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        activityMapValid = false;
+        ++boardRevision;
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, textures[currentTextureIndex]);
+    if (packedBoard) {
+        size_t wordTotal = static_cast<size_t>(textureWidth()) * GRID_HEIGHT;
+        StagingBuffer* staging = acquireStagingBuffer(wordTotal * sizeof(GLuint));
+        std::vector<GLuint> fallback;
+        GLuint* words;
+        if (staging) {
+            words = reinterpret_cast<GLuint*>(staging->ptr);
+            std::fill(words, words + wordTotal, 0u); // Staging memory holds the previous transfer
+        }
+        else {
+            fallback.resize(wordTotal, 0);
+            words = fallback.data();
+        }
+        for (int y = 0; y < GRID_HEIGHT; ++y) {
+            for (int x = 0; x < GRID_WIDTH; ++x) {
+                if (cells[static_cast<size_t>(y) * GRID_WIDTH + x]) {
+                    words[static_cast<size_t>(y) * textureWidth() + x / 32] |= (1u << (x % 32));
+                }
+            }
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureWidth(), GRID_HEIGHT, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureWidth(), GRID_HEIGHT, GL_RED_INTEGER, GL_UNSIGNED_INT, words);
+        }
+    }
+    else {
+        StagingBuffer* staging = acquireStagingBuffer(cells.size() * sizeof(float));
+        std::vector<float> fallback;
+        float* data;
+        if (staging) {
+            data = reinterpret_cast<float*>(staging->ptr);
+        }
+        else {
+            fallback.resize(cells.size());
+            data = fallback.data();
+        }
+        for (size_t i = 0; i < cells.size(); ++i) {
+            data[i] = cells[i] ? 1.0f : 0.0f;
+        }
+        if (staging) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->buffer);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_FLOAT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fenceStagingBuffer(*staging);
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GRID_WIDTH, GRID_HEIGHT, GL_RED, GL_FLOAT, data);
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    activityMapValid = false;
+    ++boardRevision;
+}
+
+void Renderer::skipGenerations(unsigned long long generations) {
+    if (generations == 0) return;
+    if (simThreadRunning.load()) {
+        std::cout << "HashLife jumps are not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (!classicRule) {
+        std::cout << "HashLife implements B3/S23 only; jumps are unavailable for rule " << ruleName << "." << std::endl;
+        return;
+    }
+    if (mutationLog) mutationLog->recordSkip(generationCount, generations);
+    std::cout << "HashLife: skipping " << generations << " generations..." << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    HashLife engine;
+    engine.setBoard(readBoardCells(), GRID_WIDTH, GRID_HEIGHT);
+    engine.advance(generations);
+    uploadBoardCells(engine.getBoard());
+    generationCount += generations;
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "HashLife: done in " << elapsed << " s, population "
+        << engine.population() << "." << std::endl;
+}
+
+void Renderer::startMutationLog(const std::string& path) {
+    mutationLog = std::make_unique<MutationLog>(path); // Throws on bad paths
+    std::cout << "Recording board mutations to " << path << "." << std::endl;
+}
+
+// Replays one recorded entry through the same code paths that produced it
+// (which also re-records it when a new log is being written).
+void Renderer::applyMutation(const Mutation& m) {
+    switch (m.type) {
+    case Mutation::Type::Randomize: randomizeBoard(m.seed); break;
+    case Mutation::Type::Clear:     clearBoard(); break;
+    case Mutation::Type::Cell:      setCell(m.x, m.y, m.alive); break;
+    case Mutation::Type::Skip:      skipGenerations(m.count); break;
+    }
+}
+
+void Renderer::resizeGrid(int newWidth, int newHeight, bool cornerPlacement) {
+    if (simThreadRunning.load()) {
+        std::cout << "Grid resizing is not available with threaded run-ahead." << std::endl;
+        return;
+    }
+    if (frameExporter) {
+        // The export ring is sized for the old grid; a mixed-size image
+        // sequence would be useless to an encoder anyway.
+        std::cout << "Frame export stopped by the grid resize." << std::endl;
+        stopFrameExport();
+    }
+
+    // 1. Update the stored dimensions, remembering the old ones
+    if (packedBoard && newWidth % 32 != 0) {
+        newWidth = ((newWidth + 31) / 32) * 32;
+        std::cout << "Packed board: grid width rounded up to " << newWidth << " (multiple of 32)." << std::endl;
+    }
+    const int oldWidth = GRID_WIDTH;
+    const int oldHeight = GRID_HEIGHT;
+    const bool oldTiled = tiledBoard();
+    GRID_WIDTH = newWidth;
+    GRID_HEIGHT = newHeight;
+    std::cout << "Resizing grid to " << GRID_WIDTH << "x" << GRID_HEIGHT
+        << " (" << (cornerPlacement ? "corner" : "center") << " placement)" << std::endl;
+
+    // 2. Stash the old objects; initTextures/initFramebuffers generate new
+    //    ones into the members.
+    GLuint oldFbo[2] = { fbo[0], fbo[1] };
+    GLuint oldTextures[2] = { textures[0], textures[1] };
+
+    // 3. Create the new-size textures/framebuffers and start them all-dead.
+    //    initTextures picks (and reports) the tiling if a dimension exceeds
+    //    the driver's maximum texture size.
+    initTextures();
+    initFramebuffers();
+
+    if (oldTiled || tiledBoard()) {
+        // The blit below maps one 2D texture onto another; there is no
+        // layer-by-layer equivalent across different tilings, so tiling
+        // transitions start from an empty board.
+        clearBoard();
+        glDeleteFramebuffers(2, oldFbo);
+        glDeleteTextures(2, oldTextures);
+        if (activityProgram && !tiledBoard()) {
+            initActivityResources();
+        }
+        if (autoStopEnabled) {
+            if (tiledBoard()) {
+                std::cout << "Auto-stop disabled: not available for tiled boards." << std::endl;
+                autoStopEnabled = false;
+            }
+            else {
+                initSignatureResources();
+            }
+            resetStabilization();
+        }
+        float maxTiledDimension = static_cast<float>(std::max(GRID_WIDTH, GRID_HEIGHT));
+        maxZoom = maxTiledDimension / 10.0f;
+        ++boardRevision;
+        resetView();
+        std::cout << "Board state is not carried across a tiling change." << std::endl;
+        return;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo[i]);
+        if (packedBoard) {
+            GLuint zero[4] = { 0, 0, 0, 0 };
+            glClearBufferuiv(GL_COLOR, 0, zero);
+        }
+        else {
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+    }
+
+    // 4. Copy the surviving region of the old board in with a blit - the
+    //    state never leaves the GPU. Offsets are in texels, so in packed
+    //    mode the centering is rounded to a 32-cell word boundary.
+    int copyWidth = std::min(oldWidth, GRID_WIDTH);
+    int copyHeight = std::min(oldHeight, GRID_HEIGHT);
+    int srcX = cornerPlacement ? 0 : (oldWidth - copyWidth) / 2;
+    int srcY = cornerPlacement ? 0 : (oldHeight - copyHeight) / 2;
+    int dstX = cornerPlacement ? 0 : (GRID_WIDTH - copyWidth) / 2;
+    int dstY = cornerPlacement ? 0 : (GRID_HEIGHT - copyHeight) / 2;
+    if (packedBoard) {
+        copyWidth /= 32;
+        srcX = (srcX / 32);
+        dstX = (dstX / 32);
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, oldFbo[currentTextureIndex]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo[currentTextureIndex]);
+    glBlitFramebuffer(srcX, srcY, srcX + copyWidth, srcY + copyHeight,
+        dstX, dstY, dstX + copyWidth, dstY + copyHeight,
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // 5. Now the old objects can go
+    glDeleteFramebuffers(2, oldFbo);
+    glDeleteTextures(2, oldTextures);
+
+    if (activityProgram) {
+        initActivityResources();
+    }
+    if (autoStopEnabled) {
+        initSignatureResources();
+        resetStabilization();
+    }
 
     // Recalculate max zoom for the new grid size
     float maxDimension = std::max(newWidth, newHeight);
     maxZoom = maxDimension / 10.0f;
+    ++boardRevision; // The textures are new; any cached mip chain is gone
 
     resetView();
 }
\ No newline at end of file
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 #include <GL/glew.h>
@@ -12,19 +16,136 @@
 
 // Forward declare GLFWwindow to avoid including the full header
 struct GLFWwindow;
+struct Pattern;
+struct Mutation;
+class SnapshotWriter;
+class MutationLog;
+class FrameExporter;
 
 class Renderer {
 public:
-    Renderer(GLFWwindow* window, int windowWidth, int windowHeight, int gridWidth, int gridHeight);
+    // When packedBoard is true the board is stored as GL_R32UI words holding
+    // 32 cells per texel (32x less VRAM and bandwidth than the float board).
+    // When useCompute is true the simulation step runs as a GL 4.3 compute
+    // dispatch with shared-memory tiling instead of a full-screen fragment
+    // pass; it silently falls back to the fragment path on older drivers.
+    // `rule` is Life-like Bnnn/Snnn notation (e.g. "B36/S23" for HighLife);
+    // it is compiled into the step kernels as birth/survival bitmask
+    // #defines, so rule selection costs nothing per cell. Throws
+    // std::runtime_error on a malformed rule string.
+    Renderer(GLFWwindow* window, int windowWidth, int windowHeight, int gridWidth, int gridHeight, bool packedBoard = false, bool useCompute = false, const std::string& rule = "B3/S23");
     ~Renderer();
 
     // --- Core Functions ---
     void runSimulationStep();
     void drawToScreen();
-    void randomizeBoard();
+    void randomizeBoard();                  // Random seed per call
+    void randomizeBoard(unsigned int seed); // Reproducible fill for benchmarks
     void clearBoard();
     void handleMouseDrawing(bool isDrawing, const std::pair<double, double>& mousePos, bool isGliderMode, int gliderRotation);
-    void resizeGrid(int newWidth, int newHeight);
+
+    // Grows or shrinks the square paint brush (1..64 cells per side).
+    void adjustBrushSize(int delta);
+
+    // Resizes the grid, carrying the current board state over with a GPU
+    // blit (no CPU round-trip). The old board lands centered in the new one
+    // by default, or in the lower-left corner with cornerPlacement.
+    void resizeGrid(int newWidth, int newHeight, bool cornerPlacement = false);
+
+    // Stamps a loaded pattern centered on the given cell with a single
+    // batched sub-image upload (existing live cells in the area survive).
+    void stampPattern(int centerX, int centerY, const Pattern& pattern);
+
+    // Jumps the board ahead by `generations` using the CPU HashLife engine
+    // and uploads the result back. Far faster than stepping for regular
+    // patterns; note that HashLife's universe is an infinite dead plane, so
+    // edge behavior differs from the GPU's toroidal wrap.
+    void skipGenerations(unsigned long long generations);
+
+    // --- Fused Double Step ---
+    // When enabled and the accumulator owes at least two generations, a
+    // single 5x5 pass advances two generations at once, halving framebuffer
+    // round-trips at high UPS settings.
+    void toggleFusedKernel();
+    bool canDoubleStep() const;
+    void runSimulationDoubleStep();
+
+    // --- Activity Tracking ---
+    // When enabled, generations only recompute 32x32 tiles that changed last
+    // generation (plus a one-tile halo); everything else is blit-copied
+    // forward. A large win on mostly-dead or static boards.
+    void toggleActivityTracking();
+
+    // --- Visible-Region Stepping ---
+    // Inspection tool for huge boards: advances only the sub-rectangle of
+    // the board currently on screen (plus a halo), derived from pan/zoom the
+    // same way mouse picks are, and carries the rest forward unchanged with
+    // a blit. At high zoom a manual step then costs what is visible, not the
+    // whole board. The off-screen remainder stays at its old generation, so
+    // this is a local probe rather than a faithful global step, and it is
+    // not covered by the mutation log. Bound to '.' while paused.
+    void stepVisibleRegion();
+
+    // --- Threaded Run-Ahead ---
+    // Moves the simulation onto a worker thread with a shared GL context: it
+    // steps continuously and publishes each completed generation through a
+    // fence, while drawToScreen adopts whatever generation is newest. A slow
+    // draw or a V-Sync'd swap no longer steals simulation time. Plain float
+    // fragment path only; most interactive features are unavailable while
+    // active (soak-run mode). Started once at launch via --threaded.
+    void startThreadedSimulation();
+    bool threadedSimulation() const { return simThreadRunning.load(); }
+    void setSimulationPaused(bool paused) { simPaused.store(paused); }
+
+    // --- Snapshots ---
+    // Asynchronous board snapshots: requestSnapshot kicks a glReadPixels into
+    // a PBO from the ring and fences it; pollSnapshots (call once per frame)
+    // collects any readback whose fence has signaled and hands it to a
+    // background thread for bit-packing and disk I/O. The render thread
+    // never waits on the GPU or the filesystem.
+    void requestSnapshot(const std::string& path);
+    void pollSnapshots();
+
+    // Replaces the board (resizing if needed) from a checkpoint file and
+    // restores its generation count and seed. Synchronous by design: it runs
+    // at startup or on explicit user request, never mid-simulation.
+    void loadCheckpoint(const std::string& path);
+    unsigned long long getGeneration() const { return generationCount; }
+
+    // --- Frame Export ---
+    // Timelapse recording: every Nth generation the board is read back
+    // through an async PBO ring and handed to background encoder threads
+    // writing a numbered PGM sequence (see FrameExporter.h). The GL thread
+    // never waits: when the ring or the encoder queue is saturated the
+    // frame is dropped and counted, and the totals are reported at exit.
+    void startFrameExport(const std::string& directory, int everyN);
+
+    // --- Mutation Recording / Replay ---
+    // With a log attached, every board mutation (randomize, clear, cell
+    // writes, HashLife skips) is appended to it tagged with the generation
+    // it was applied at; applyMutation replays one such entry. See
+    // MutationLog.h for the format and what is deliberately not covered.
+    void startMutationLog(const std::string& path);
+    void applyMutation(const Mutation& m);
+
+    // --- Stabilization Auto-Stop ---
+    // With auto-stop enabled (--auto-stop), every STABILITY_CHECK_INTERVAL
+    // generations the board is reduced on the GPU to a position-weighted
+    // checksum (a fragment pass into a mip-chained texture, read back through
+    // fenced PBOs like the population counter, so it never stalls). A
+    // signature seen before at the same spacing twice in a row means the
+    // board is a still life or a short-period oscillator; boardStabilized()
+    // then latches true until resetStabilization() re-arms the detector.
+    void enableAutoStop();
+    bool boardStabilized() const { return stabilized; }
+    void resetStabilization();
+
+    // --- Statistics ---
+    // Kicks off / collects the asynchronous population reduction. Call once
+    // per frame; results trail the simulation by a frame or two by design.
+    void updateStatistics();
+    long long getPopulation() const { return population; }       // -1 if unavailable
+    long long getPopulationDelta() const { return populationDelta; }
 
     // --- Event Handlers ---
     void onWindowResize(int newWidth, int newHeight);
@@ -39,26 +160,225 @@ public:
 
 private:
     GLFWwindow* window;
-    
+
+    // Letterbox points clamp to the board edge instead of the pick sentinel;
+    // for rectangle queries built from the window corners.
+    std::pair<float, float> screenToTextureCoordsClamped(double screenX, double screenY) const;
+
     void initQuad();
     void initTextures();
     void initFramebuffers();
     void drawPattern(int centerX, int centerY, const std::vector<std::pair<int, int>>& pattern, int rotation);
+    void setCell(int x, int y, bool alive);
+    void paintCells(const std::vector<std::pair<int, int>>& cells);
+    std::vector<unsigned char> readBoardCells();                // Row-major 0/1
+    void uploadBoardCells(const std::vector<unsigned char>& cells);
+    void initActivityResources();
+    void updateActivityMap();
+    void refreshMipmaps();
+    int tilesX() const { return (GRID_WIDTH + 31) / 32; }
+    int tilesY() const { return (GRID_HEIGHT + 31) / 32; }
+
+    // Width of the board texture in texels. In packed mode 32 cells share one
+    // R32UI texel, so the texture is 32x narrower than the logical grid.
+    int textureWidth() const { return packedBoard ? GRID_WIDTH / 32 : GRID_WIDTH; }
+
+    // True when the board is split across a texture-array tiling because a
+    // dimension exceeds GL_MAX_TEXTURE_SIZE (see initTextures).
+    bool tiledBoard() const { return tileCols > 1 || tileRows > 1; }
+    void attachTileLayer(GLuint framebuffer, GLuint texture, int layer);
 
     // Window and Grid dimensions
     int windowWidth;
     int windowHeight;
     int GRID_WIDTH;
     int GRID_HEIGHT;
+    bool packedBoard;
 
     // OpenGL resources
     std::unique_ptr<Shader> computeProgram;
+    std::unique_ptr<Shader> computeEngineProgram; // GL 4.3 compute dispatch path
+    std::unique_ptr<Shader> randomizeProgram;     // GPU-side board fill
+    std::unique_ptr<Shader> doubleStepProgram;    // Two generations per pass
     std::unique_ptr<Shader> drawProgram;
+    std::unique_ptr<Shader> cellsProgram;        // Instanced high-zoom cell path
+    bool computeEngine = false;
+    bool fusedKernel = false;
+
+    // Tiled virtual grid: boards larger than GL_MAX_TEXTURE_SIZE live in a
+    // GL_TEXTURE_2D_ARRAY of square tiles (one layer per tile), stepped and
+    // drawn by shader variants that map global cell coordinates to a layer
+    // and local texel, so toroidal wrap works across tile seams with no halo
+    // copies. Untiled boards (tileCols == tileRows == 1) are untouched.
+    int tileSize = 0;
+    int tileCols = 1;
+    int tileRows = 1;
+    std::unique_ptr<Shader> computeTiledProgram;
+    std::unique_ptr<Shader> drawTiledProgram;
+    std::unique_ptr<Shader> randomizeTiledProgram;
     GLuint fbo[2];
     GLuint textures[2];
     int currentTextureIndex = 0;
     GLuint quadVAO, quadVBO;
 
+    // Activity tracking state. tileWorkList holds one byte per 32x32 tile:
+    // nonzero means the tile (or a neighbor, after halo dilation) changed
+    // last generation and must be recomputed. When the map is invalid (after
+    // any direct board mutation) the next step updates everything.
+    std::unique_ptr<Shader> activityProgram;
+    bool activityTracking = false;
+    bool activityMapValid = false;
+    GLuint activityTex = 0;
+    GLuint activityFbo = 0;
+    std::vector<unsigned char> tileWorkList;
+
+    // Threaded run-ahead state. The worker steps in a hidden window that
+    // shares the main context, so textures, programs and fences are common
+    // but container objects (FBOs, VAOs) are per-thread. Three board
+    // textures (the ping-pong pair plus one spare) triple-buffer the
+    // run-ahead: each step writes the texture that is neither its source nor
+    // the one on screen, so neither thread ever waits for the other. Board
+    // fills are forwarded to the worker through simCommand; everything else
+    // that would touch the board cross-thread is declined while active.
+    void simThreadMain();
+    void stopThreadedSimulation();
+    GLFWwindow* simWindow = nullptr;
+    std::thread simThread;
+    std::atomic<bool> simThreadRunning{ false };
+    std::atomic<bool> simThreadStop{ false };
+    std::atomic<bool> simPaused{ false };
+    std::atomic<int> displayedBoard{ -1 };     // Index the main thread last drew
+    std::atomic<unsigned int> simCommand{ 0 }; // 0 none, 1 clear, 2 randomize
+    std::atomic<unsigned int> simCommandSeed{ 0 };
+    GLuint runAheadTexture = 0;                // The third board texture
+    GLuint boardTriple[3] = { 0, 0, 0 };       // Ping-pong pair + spare
+    std::mutex publishMutex;                   // Guards the publish slot below
+    int publishedBoard = -1;
+    GLsync publishedFence = nullptr;
+    GLsync displayFence = nullptr;             // Orders steps after the last draw
+    unsigned long long publishedGeneration = 0;
+
+    // Persistently-mapped staging pool for CPU-to-GPU board transfers
+    // (ARB_buffer_storage). Writes go straight into driver-visible memory
+    // with no transient allocation, and a fence per slot guarantees the GPU
+    // finished the previous transfer before the slot is reused, so the
+    // writes themselves never synchronize. acquireStagingBuffer returns
+    // null when the extension is missing; callers then fall back to a
+    // plain client-memory transfer.
+    static constexpr int STAGING_POOL_SIZE = 3;
+    struct StagingBuffer {
+        GLuint buffer = 0;
+        unsigned char* ptr = nullptr; // Persistent mapping
+        GLsync fence = nullptr;       // Non-null while a transfer is in flight
+        size_t capacity = 0;
+    };
+    StagingBuffer stagingPool[STAGING_POOL_SIZE];
+    StagingBuffer* acquireStagingBuffer(size_t bytes);
+    void fenceStagingBuffer(StagingBuffer& staging);
+    void destroyStagingPool();
+
+    // Stabilization detection state (see enableAutoStop). signatureHistory
+    // holds the most recent samples; a repeated signature is only a
+    // candidate period (float averaging can collide), promoted to a verdict
+    // when the next sample repeats at the same spacing.
+    static constexpr unsigned long long STABILITY_CHECK_INTERVAL = 64;
+    static constexpr size_t SIGNATURE_WINDOW = 16;
+    struct BoardSignature {
+        unsigned long long generation;
+        float value;
+    };
+    void initSignatureResources();
+    void checkStabilization();
+    bool autoStopEnabled = false;
+    bool stabilized = false;
+    std::unique_ptr<Shader> signatureProgram;
+    GLuint signatureTex = 0;
+    GLuint signatureFbo = 0;
+    GLuint signaturePbo[2] = { 0, 0 };
+    GLsync signatureFence[2] = { nullptr, nullptr };
+    unsigned long long signatureGen[2] = { 0, 0 };
+    int signatureWriteIndex = 0;
+    std::vector<BoardSignature> signatureHistory;
+    unsigned long long pendingPeriod = 0;
+
+    // Brush stroke state. Consecutive mouse samples are joined with a
+    // Bresenham line so fast strokes leave no gaps, every line cell gets the
+    // NxN brush footprint, and the whole segment flushes as one batched
+    // sub-image upload per frame instead of one driver call per cell.
+    int brushSize = 1;
+    bool strokeActive = false;
+    int strokeLastX = 0;
+    int strokeLastY = 0;
+
+    // Per-frame view parameters (pan/zoom/resolutions) live in a small UBO
+    // at binding point 0 instead of individual glUniform calls. With
+    // ARB_buffer_storage it is persistently mapped as a three-slot ring so
+    // the CPU write never waits on a frame the GPU is still reading;
+    // otherwise it falls back to one glBufferSubData per frame.
+    static constexpr int VIEW_UBO_SLOTS = 3;
+    GLuint viewUbo = 0;
+    unsigned char* viewUboPtr = nullptr; // Persistent mapping, null on fallback
+    int viewUboSlot = 0;
+    GLint viewUboStride = 0; // Slot size, rounded to the UBO offset alignment
+
+    // Snapshot PBO ring. A slot is in flight from the glReadPixels kick-off
+    // until its fence signals and the mapped data is handed to the writer.
+    static constexpr int SNAPSHOT_RING_SIZE = 3;
+    std::unique_ptr<SnapshotWriter> snapshotWriter;
+
+    // Non-null while recording board mutations (--record)
+    std::unique_ptr<MutationLog> mutationLog;
+
+    // Frame export PBO ring; same in-flight discipline as the snapshot ring
+    // but sized deeper because captures recur every exportEvery generations.
+    static constexpr int EXPORT_RING_SIZE = 4;
+    std::unique_ptr<FrameExporter> frameExporter;
+    int exportEvery = 0;
+    // Next generation due for capture. A threshold rather than a modulo test
+    // so the fused double step (generationCount += 2) cannot jump over a
+    // capture point.
+    unsigned long long exportNextCaptureGen = 0;
+    GLuint exportPbo[EXPORT_RING_SIZE] = { 0, 0, 0, 0 };
+    GLsync exportFence[EXPORT_RING_SIZE] = { nullptr, nullptr, nullptr, nullptr };
+    unsigned long long exportFrameGen[EXPORT_RING_SIZE] = { 0, 0, 0, 0 };
+    unsigned long long exportRingDrops = 0;
+    void serviceFrameExport();
+    void captureExportFrame();
+    void pollExportFrames();
+    void stopFrameExport();
+    GLuint snapshotPbo[SNAPSHOT_RING_SIZE] = { 0, 0, 0 };
+    GLsync snapshotFence[SNAPSHOT_RING_SIZE] = { nullptr, nullptr, nullptr };
+    std::string snapshotPath[SNAPSHOT_RING_SIZE];
+    unsigned long long snapshotGeneration[SNAPSHOT_RING_SIZE] = { 0, 0, 0 };
+
+    // The active Life-like rule. The preamble is the #define block injected
+    // into every step kernel; classicRule gates the CPU-side engines
+    // (HashLife), which implement B3/S23 only.
+    std::string ruleName = "B3/S23";
+    std::string rulePreamble;
+    bool classicRule = true;
+
+    // Mip pyramid bookkeeping. boardRevision bumps on every step or board
+    // mutation; refreshMipmaps regenerates the current texture's mip chain
+    // only when it is stale, so the statistics reduction and the zoomed-out
+    // LOD draw path share one reduction per generation.
+    unsigned long long boardRevision = 1;
+    unsigned long long mipmapRevision = 0;
+
+    // Checkpoint header bookkeeping: generations advanced since the board
+    // was last filled, and the seed that filled it (0 for hand-drawn boards).
+    unsigned long long generationCount = 0;
+    unsigned int boardSeed = 0;
+
+    // Population statistics: the board's mip chain reduces to a 1x1 average,
+    // which is read back through a pair of PBOs guarded by fence syncs so the
+    // pipeline never stalls. Not available for the packed (integer) board.
+    GLuint statsPbo[2] = { 0, 0 };
+    GLsync statsFence[2] = { nullptr, nullptr };
+    int statsWriteIndex = 0;
+    long long population = -1;
+    long long populationDelta = 0;
+
     // View state
     float panX = 0.0f;
     float panY = 0.0f;
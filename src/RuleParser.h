@@ -0,0 +1,44 @@
+// src/RuleParser.h
+// Parses Life-like Bnnn/Snnn rule notation into neighbor-count bitmasks and
+// builds the #define preamble injected into the step kernels. Shared by the
+// interactive Renderer and the headless BatchRunner.
+
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// Parses Bnnn/Snnn rule notation ("B3/S23", "B36/S23", "B3678/S34678",
+// "B2/S" for Seeds...) into neighbor-count bitmasks: bit n set means the
+// transition happens with n live neighbors. Throws std::runtime_error on
+// malformed notation.
+inline void parseLifeRule(const std::string& rule, unsigned int& birthMask, unsigned int& survivalMask) {
+    birthMask = 0;
+    survivalMask = 0;
+    unsigned int* target = nullptr;
+    bool sawBirth = false, sawSurvival = false;
+
+    for (char c : rule) {
+        if (c == 'B' || c == 'b') { target = &birthMask; sawBirth = true; }
+        else if (c == 'S' || c == 's') { target = &survivalMask; sawSurvival = true; }
+        else if (c == '/') { target = nullptr; }
+        else if (c >= '0' && c <= '8' && target) { *target |= 1u << (c - '0'); }
+        else {
+            throw std::runtime_error("Malformed rule \"" + rule + "\" (expected Bnnn/Snnn notation)");
+        }
+    }
+    if (!sawBirth || !sawSurvival) {
+        throw std::runtime_error("Malformed rule \"" + rule + "\" (expected Bnnn/Snnn notation)");
+    }
+}
+
+// The #define block injected right after the #version directive of every
+// step kernel; each distinct rule becomes its own cached program variant.
+inline std::string makeRulePreamble(unsigned int birthMask, unsigned int survivalMask) {
+    char preamble[96];
+    std::snprintf(preamble, sizeof(preamble),
+        "#define BIRTH_MASK 0x%02Xu\n#define SURVIVAL_MASK 0x%02Xu\n",
+        birthMask, survivalMask);
+    return preamble;
+}
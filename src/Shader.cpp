@@ -3,11 +3,110 @@
 
 #include "Shader.h"
 #include <GL/glew.h>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+namespace {
+
+    // --- Program binary cache ---
+    // After the first link, the driver's compiled program blob is stored in
+    // shader_cache/ keyed by a hash of the GLSL source and the driver
+    // identification strings. Later launches load the blob with
+    // glProgramBinary and skip compilation entirely; any mismatch (edited
+    // shader, driver update, blob rejected) silently falls back to a source
+    // compile and refreshes the cache entry.
+
+    bool binaryCacheSupported() {
+        if (!GLEW_ARB_get_program_binary) return false;
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }
+
+    // FNV-1a over the shader source plus the renderer/version strings, so a
+    // driver or GPU change invalidates every entry automatically.
+    std::string cacheKey(const std::string& source) {
+        std::uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](const char* s) {
+            for (; s && *s; ++s) {
+                hash ^= static_cast<unsigned char>(*s);
+                hash *= 1099511628211ull;
+            }
+        };
+        mix(source.c_str());
+        mix(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        mix(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+        return buffer;
+    }
+
+    std::filesystem::path cachePath(const std::string& key) {
+        return std::filesystem::path("shader_cache") / (key + ".bin");
+    }
+
+    // Returns a linked program from the cache, or 0 on any mismatch.
+    GLuint tryLoadCachedProgram(const std::string& key) {
+        std::ifstream file(cachePath(key), std::ios::binary | std::ios::ate);
+        if (!file) return 0;
+
+        auto size = file.tellg();
+        if (size <= static_cast<std::streamoff>(sizeof(GLenum))) return 0;
+        file.seekg(0);
+
+        GLenum format = 0;
+        file.read(reinterpret_cast<char*>(&format), sizeof(format));
+        std::vector<char> blob(static_cast<size_t>(size) - sizeof(format));
+        file.read(blob.data(), blob.size());
+        if (!file) return 0;
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, format, blob.data(), static_cast<GLsizei>(blob.size()));
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            glDeleteProgram(program);
+            return 0; // Stale blob; the caller recompiles and overwrites it
+        }
+        return program;
+    }
+
+    void storeCachedProgram(GLuint program, const std::string& key) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+
+        std::vector<char> blob(length);
+        GLenum format = 0;
+        glGetProgramBinary(program, length, nullptr, &format, blob.data());
+
+        std::error_code ec;
+        std::filesystem::create_directories("shader_cache", ec);
+        std::ofstream file(cachePath(key), std::ios::binary);
+        if (!file) return; // Cache is best-effort; never fail the launch
+        file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        file.write(blob.data(), blob.size());
+    }
+
+    // Inserts the preamble right after the #version line (GLSL requires
+    // #version to be the first directive in the file).
+    std::string injectPreamble(const std::string& source, const std::string& preamble) {
+        if (preamble.empty()) return source;
+        size_t versionPos = source.find("#version");
+        if (versionPos == std::string::npos) return preamble + source;
+        size_t lineEnd = source.find('\n', versionPos);
+        if (lineEnd == std::string::npos) return source + "\n" + preamble;
+        return source.substr(0, lineEnd + 1) + preamble + source.substr(lineEnd + 1);
+    }
+
+} // namespace
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const std::string& preamble) {
     // 1. Retrieve the vertex/fragment source code from filePath
     std::string vertexCode;
     std::string fragmentCode;
@@ -37,10 +136,21 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         // It's better to throw an exception here to halt execution if shaders can't be loaded.
         throw;
     }
+    fragmentCode = injectPreamble(fragmentCode, preamble);
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    // 2. Compile shaders
+    // 2. Check the binary cache before touching the compiler
+    const bool cacheable = binaryCacheSupported();
+    std::string key;
+    if (cacheable) {
+        key = cacheKey(vertexCode + "\n" + fragmentCode);
+        if ((ID = tryLoadCachedProgram(key)) != 0) {
+            return;
+        }
+    }
+
+    // 3. Compile shaders
     unsigned int vertex, fragment;
 
     // Vertex Shader
@@ -59,32 +169,110 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     ID = glCreateProgram();
     glAttachShader(ID, vertex);
     glAttachShader(ID, fragment);
+    if (cacheable) {
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(ID);
     checkCompileErrors(ID, "PROGRAM");
 
     // Delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    if (cacheable) {
+        storeCachedProgram(ID, key);
+    }
+}
+
+Shader::Shader(const char* computePath, const std::string& preamble) {
+    // 1. Retrieve the compute source code from filePath
+    std::string computeCode;
+    std::ifstream cShaderFile;
+    cShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    try {
+        cShaderFile.open(computePath);
+        std::stringstream cShaderStream;
+        cShaderStream << cShaderFile.rdbuf();
+        cShaderFile.close();
+        computeCode = cShaderStream.str();
+    }
+    catch (std::ifstream::failure& e) {
+        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        throw;
+    }
+    computeCode = injectPreamble(computeCode, preamble);
+    const char* cShaderCode = computeCode.c_str();
+
+    // 2. Check the binary cache before touching the compiler
+    const bool cacheable = binaryCacheSupported();
+    std::string key;
+    if (cacheable) {
+        key = cacheKey(computeCode);
+        if ((ID = tryLoadCachedProgram(key)) != 0) {
+            return;
+        }
+    }
+
+    // 3. Compile and link
+    unsigned int compute = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(compute, 1, &cShaderCode, NULL);
+    glCompileShader(compute);
+    checkCompileErrors(compute, "COMPUTE");
+
+    ID = glCreateProgram();
+    glAttachShader(ID, compute);
+    if (cacheable) {
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(ID);
+    checkCompileErrors(ID, "PROGRAM");
+
+    glDeleteShader(compute);
+
+    if (cacheable) {
+        storeCachedProgram(ID, key);
+    }
 }
 
 void Shader::use() const {
     glUseProgram(ID);
 }
 
+int Shader::uniformLocation(const std::string& name) const {
+    auto it = uniformLocations.find(name);
+    if (it != uniformLocations.end()) {
+        return it->second;
+    }
+    int location = glGetUniformLocation(ID, name.c_str());
+    uniformLocations.emplace(name, location);
+    return location;
+}
+
 void Shader::setBool(const std::string& name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    glUniform1i(uniformLocation(name), (int)value);
 }
 
 void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(uniformLocation(name), value);
+}
+
+void Shader::setUInt(const std::string& name, unsigned int value) const {
+    glUniform1ui(uniformLocation(name), value);
 }
 
 void Shader::setFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1f(uniformLocation(name), value);
 }
 
 void Shader::setVec2(const std::string& name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    glUniform2f(uniformLocation(name), x, y);
+}
+
+void Shader::bindUniformBlock(const std::string& name, unsigned int bindingPoint) const {
+    unsigned int index = glGetUniformBlockIndex(ID, name.c_str());
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(ID, index, bindingPoint);
+    }
 }
 
 
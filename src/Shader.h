@@ -4,24 +4,42 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 class Shader {
 public:
-    // Constructor reads and builds the shader
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // Constructor reads and builds the shader. The optional preamble is a
+    // block of #define lines injected right after the fragment shader's
+    // #version directive, used to specialize kernels at compile time (e.g.
+    // Life-like rule masks). Each distinct preamble is a distinct program,
+    // including in the binary cache.
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& preamble = "");
+
+    // Constructor for a compute shader program (requires GL 4.3); the
+    // preamble is injected the same way.
+    explicit Shader(const char* computePath, const std::string& preamble = "");
 
     // Use/activate the shader
     void use() const;
 
-    // Utility uniform functions
+    // Utility uniform functions (locations are cached; the driver string
+    // lookup happens once per uniform, not once per call)
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
+    void setUInt(const std::string& name, unsigned int value) const;
     void setFloat(const std::string& name, float value) const;
     void setVec2(const std::string& name, float x, float y) const;
 
+    // Binds a named uniform block to a buffer binding point
+    void bindUniformBlock(const std::string& name, unsigned int bindingPoint) const;
+
 private:
     unsigned int ID; // The program ID
 
+    // First set* call for a name resolves and caches its location
+    int uniformLocation(const std::string& name) const;
+    mutable std::unordered_map<std::string, int> uniformLocations;
+
     // Utility function for checking shader compilation/linking errors.
     void checkCompileErrors(unsigned int shader, std::string type);
 };
@@ -0,0 +1,90 @@
+// src/SnapshotWriter.cpp
+// Implementation of the background snapshot writer.
+
+#include "SnapshotWriter.h"
+#include "Checkpoint.h"
+#include <iostream>
+
+SnapshotWriter::SnapshotWriter() {
+    worker = std::thread(&SnapshotWriter::workerLoop, this);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SnapshotWriter::enqueue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    condition.notify_one();
+}
+
+int SnapshotWriter::pendingJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(jobs.size());
+}
+
+void SnapshotWriter::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping and fully drained
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        writeSnapshot(job);
+    }
+}
+
+// Bit-packs the raw readback into rows of 8 cells per byte (LSB-first,
+// bottom-to-top as GL reads them) and hands the result to the checkpoint
+// format for compression and writing.
+void SnapshotWriter::writeSnapshot(const Job& job) const {
+    const int bytesPerRow = (job.width + 7) / 8;
+    std::vector<unsigned char> packed(static_cast<size_t>(bytesPerRow) * job.height, 0);
+
+    for (int y = 0; y < job.height; ++y) {
+        unsigned char* row = packed.data() + static_cast<size_t>(y) * bytesPerRow;
+        if (job.packedWords) {
+            // Source row is width/32 R32UI words; fan each out to four bytes.
+            const int wordsPerRow = job.width / 32;
+            const std::uint32_t* words = reinterpret_cast<const std::uint32_t*>(job.data.data())
+                + static_cast<size_t>(y) * wordsPerRow;
+            for (int w = 0; w < wordsPerRow; ++w) {
+                std::uint32_t word = words[w];
+                row[w * 4 + 0] = word & 0xFF;
+                row[w * 4 + 1] = (word >> 8) & 0xFF;
+                row[w * 4 + 2] = (word >> 16) & 0xFF;
+                row[w * 4 + 3] = (word >> 24) & 0xFF;
+            }
+        }
+        else {
+            const unsigned char* cells = job.data.data() + static_cast<size_t>(y) * job.width;
+            for (int x = 0; x < job.width; ++x) {
+                if (cells[x]) {
+                    row[x / 8] |= (1u << (x % 8));
+                }
+            }
+        }
+    }
+
+    try {
+        CheckpointFile::write(job.path, job.width, job.height, job.generation, job.seed, packed);
+        std::cout << "Checkpoint written: " << job.path << " (" << job.width << "x" << job.height
+            << ", generation " << job.generation << ")" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
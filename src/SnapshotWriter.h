@@ -0,0 +1,44 @@
+// src/SnapshotWriter.h
+// Background disk writer for board checkpoints. The render thread hands raw
+// readback buffers to enqueue(); a worker thread bit-packs them, compresses
+// and writes them in the checkpoint format (see Checkpoint.h), so the GL
+// thread never blocks on compression or the filesystem.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SnapshotWriter {
+public:
+    struct Job {
+        std::string path;
+        int width;        // Logical grid width in cells
+        int height;
+        unsigned long long generation; // Recorded in the checkpoint header
+        unsigned int seed;
+        bool packedWords; // Data is R32UI words (32 cells each), not bytes
+        std::vector<unsigned char> data;
+    };
+
+    SnapshotWriter();
+    ~SnapshotWriter(); // Drains the queue before returning
+
+    void enqueue(Job job);
+    int pendingJobs() const;
+
+private:
+    void workerLoop();
+    void writeSnapshot(const Job& job) const;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Job> jobs;
+    bool stopping = false;
+    std::thread worker;
+};
@@ -3,7 +3,12 @@
 // It creates and runs the GameOfLife application instance.
 
 #include "GameOfLife.h"
+#include "AppConfig.h"
+#include "CpuEngine.h"
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 // --- Configuration ---
 // The grid can be any size. The renderer will add letter/pillarboxing to maintain the aspect ratio.
@@ -12,10 +17,149 @@ int GRID_HEIGHT = 200;
 constexpr int INITIAL_WINDOW_WIDTH = 800;
 constexpr int INITIAL_WINDOW_HEIGHT = 800;
 
-int main() {
+// Runs the bit-parallel CPU engine headlessly: no GLFW, no GLEW, no window.
+// This is the path for GPU-less batch and CI nodes.
+static int runCpuBenchmark(int width, int height, int generations) {
+    try {
+        CpuEngine engine(width, height);
+        if (engine.width() != width) {
+            std::cout << "CPU engine: grid width rounded up to " << engine.width() << " (multiple of 64)." << std::endl;
+        }
+        std::cout << "CPU benchmark: " << engine.width() << "x" << engine.height()
+            << " grid, " << generations << " generations"
+#if defined(__AVX2__)
+            << ", AVX2 kernel"
+#else
+            << ", scalar 64-bit kernel"
+#endif
+            << std::endl;
+
+        engine.randomize(1234);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i) {
+            engine.step();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double cells = static_cast<double>(engine.width()) * engine.height();
+        std::cout << "Wall time:        " << seconds * 1000.0 << " ms\n"
+            << "Generations/sec:  " << generations / seconds << "\n"
+            << "Cell-updates/sec: " << (generations / seconds) * cells << "\n"
+            << "Final population: " << engine.population() << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "An unexpected error occurred: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --packed stores the board as 32 cells per R32UI texel instead of one
+    // float per cell. Recommended for large grids (16k and up).
+    // --compute runs the simulation step as a GL 4.3 compute dispatch with
+    // shared-memory tiling (falls back to the fragment path on 3.3 drivers).
+    // --bench W H N runs N generations on a WxH grid offscreen, prints
+    // throughput (generations/sec, cell-updates/sec, GPU time/step) and exits.
+    AppConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--packed") {
+            config.packedBoard = true;
+        }
+        else if (arg == "--compute") {
+            config.useCompute = true;
+        }
+        else if (arg == "--timing-log" && i + 1 < argc) {
+            config.timingLogPath = argv[++i];
+        }
+        else if (arg == "--rule" && i + 1 < argc) {
+            // Life-like rule, e.g. --rule B36/S23 for HighLife or
+            // --rule B2/S for Seeds. Default is Conway's B3/S23.
+            config.rule = argv[++i];
+        }
+        else if (arg == "--export" && i + 2 < argc) {
+            // Timelapse recording: every Nth generation lands in <dir> as a
+            // numbered PGM frame (ffmpeg ingests the sequence directly).
+            config.exportDir = argv[++i];
+            config.exportEvery = std::atoi(argv[++i]);
+            if (config.exportEvery <= 0) {
+                std::cerr << "Usage: --export <directory> <every-N-generations>" << std::endl;
+                return -1;
+            }
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            // Deterministic initial fill: two runs with the same seed (and
+            // the same inputs) evolve bit-identical boards.
+            config.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            config.hasSeed = true;
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            // Append every board mutation to this log for later --replay.
+            config.recordLogPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            // Re-apply a recorded mutation log at the generations it was
+            // captured at. Combine with --bench for reproducible workloads.
+            config.replayLogPath = argv[++i];
+        }
+        else if (arg == "--auto-stop") {
+            // Detects still lifes and short-period oscillators with a
+            // periodic GPU checksum; pauses (or ends --bench runs) when the
+            // board stops producing anything new.
+            config.autoStop = true;
+        }
+        else if (arg == "--threaded") {
+            // Simulation on a worker thread with a shared GL context: steps
+            // continuously and the display shows whatever generation is
+            // newest, so V-Sync never caps the simulation rate.
+            config.threaded = true;
+        }
+        else if (arg == "--cpu-bench" && i + 3 < argc) {
+            // Fully headless: never initializes OpenGL, so it runs on nodes
+            // without a GPU or display at all.
+            int w = std::atoi(argv[++i]);
+            int h = std::atoi(argv[++i]);
+            int n = std::atoi(argv[++i]);
+            if (w <= 0 || h <= 0 || n <= 0) {
+                std::cerr << "Usage: --cpu-bench <width> <height> <generations>" << std::endl;
+                return -1;
+            }
+            return runCpuBenchmark(w, h, n);
+        }
+        else if (arg == "--batch" && i + 4 < argc) {
+            // Ensemble sweep: K independent WxH boards packed into one atlas
+            // and stepped together for N generations, with per-board final
+            // populations reported. Combine with --seed for reproducibility.
+            config.batchCount = std::atoi(argv[++i]);
+            config.batchWidth = std::atoi(argv[++i]);
+            config.batchHeight = std::atoi(argv[++i]);
+            config.batchGenerations = std::atoi(argv[++i]);
+            if (config.batchCount <= 0 || config.batchWidth <= 0
+                || config.batchHeight <= 0 || config.batchGenerations <= 0) {
+                std::cerr << "Usage: --batch <boards> <width> <height> <generations>" << std::endl;
+                return -1;
+            }
+        }
+        else if (arg == "--bench" && i + 3 < argc) {
+            config.benchmark = true;
+            config.benchWidth = std::atoi(argv[++i]);
+            config.benchHeight = std::atoi(argv[++i]);
+            config.benchGenerations = std::atoi(argv[++i]);
+            if (config.benchWidth <= 0 || config.benchHeight <= 0 || config.benchGenerations <= 0) {
+                std::cerr << "Usage: --bench <width> <height> <generations>" << std::endl;
+                return -1;
+            }
+        }
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return -1;
+        }
+    }
+
     try {
         // Create the main application object
-        GameOfLife game(INITIAL_WINDOW_WIDTH, INITIAL_WINDOW_HEIGHT, GRID_WIDTH, GRID_HEIGHT, "GPU Conway's Game of Life");
+        GameOfLife game(INITIAL_WINDOW_WIDTH, INITIAL_WINDOW_HEIGHT, GRID_WIDTH, GRID_HEIGHT, "GPU Conway's Game of Life", config);
 
         // Start the main loop
         game.run();